@@ -26,6 +26,21 @@
 #define swap4(a, b) { (a)[0] = (b)[3], (a)[1] = (b)[2], (a)[2] = (b)[1], (a)[3] = (b)[0]; }
 
 
+//---------------------------------------------------------
+//   fnv1a
+//    FNV-1a hash, used to key the wavetable cache
+//---------------------------------------------------------
+
+uint32_t fnv1a (uint32_t h, const void* data, int n)
+      {
+      const unsigned char* p = static_cast<const unsigned char*>(data);
+      for (int i = 0; i < n; i++) {
+            h ^= p [i];
+            h *= 16777619u;
+            }
+      return h;
+      }
+
 //---------------------------------------------------------
 //   N_func
 //---------------------------------------------------------
@@ -267,6 +282,47 @@ void Addsynth::reset()
       _h_atp.reset (0.0f);
       }
 
+//---------------------------------------------------------
+//   hash
+//    hash of all parameters that affect the generated
+//    waveforms; names and comments are not included
+//---------------------------------------------------------
+
+uint32_t N_func::hash (uint32_t h) const
+      {
+      h = fnv1a (h, &_b, sizeof (_b));
+      return fnv1a (h, _v, sizeof (_v));
+      }
+
+uint32_t HN_func::hash (uint32_t h) const
+      {
+      for (int i = 0; i < N_HARM; i++)
+            h = _h [i].hash (h);
+      return h;
+      }
+
+uint32_t Addsynth::hash () const
+      {
+      uint32_t h = 2166136261u;
+      h = fnv1a (h, &_n0, sizeof (_n0));
+      h = fnv1a (h, &_n1, sizeof (_n1));
+      h = fnv1a (h, &_fn, sizeof (_fn));
+      h = fnv1a (h, &_fd, sizeof (_fd));
+      h = _n_vol.hash (h);
+      h = _n_off.hash (h);
+      h = _n_ran.hash (h);
+      h = _n_ins.hash (h);
+      h = _n_att.hash (h);
+      h = _n_atd.hash (h);
+      h = _n_dct.hash (h);
+      h = _n_dcd.hash (h);
+      h = _h_lev.hash (h);
+      h = _h_ran.hash (h);
+      h = _h_att.hash (h);
+      h = _h_atp.hash (h);
+      return h;
+      }
+
 //---------------------------------------------------------
 //   save
 //---------------------------------------------------------
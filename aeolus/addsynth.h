@@ -26,6 +26,8 @@
 #define NOTE_MAX 96
 
 
+extern uint32_t fnv1a (uint32_t h, const void* data, int n);
+
 //---------------------------------------------------------
 //   N_func
 //---------------------------------------------------------
@@ -53,6 +55,7 @@ class N_func
             }
       void write(FILE*);
       void read(QFile*);
+      uint32_t hash(uint32_t h) const;
       };
 
 //---------------------------------------------------------
@@ -76,6 +79,7 @@ class HN_func
       float vi (int h, int n) const { return _h [h].vi (n); }
       void write (FILE *F, int k);
       void read (QFile *F, int k);
+      uint32_t hash (uint32_t h) const;
       };
 
 //---------------------------------------------------------
@@ -90,6 +94,7 @@ class Addsynth
       void reset();
       int save (const char *sdir);
       int load (const char *sdir);
+      uint32_t hash () const;
 
       char       _filename [64];
       char       _stopname [32];
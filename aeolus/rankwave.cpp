@@ -450,6 +450,37 @@ void Rankwave::play (int shift)
 }
 
 
+//---------------------------------------------------------
+//   cache_key
+//    identifies the generated waveforms: the stop
+//    parameters, the sample rate, the tuning and the
+//    temperament
+//---------------------------------------------------------
+
+uint32_t Rankwave::cache_key (Addsynth *D, float fsamp, float fbase, float *scale)
+{
+    uint32_t h = D->hash ();
+    h = fnv1a (h, &fsamp, sizeof (float));
+    h = fnv1a (h, &fbase, sizeof (float));
+    return fnv1a (h, scale, 12 * sizeof (float));
+}
+
+
+//---------------------------------------------------------
+//   cache_name
+//    <path>/<stop file name>-<key>.ae1
+//---------------------------------------------------------
+
+void Rankwave::cache_name (char *name, const char *path, Addsynth *D, uint32_t key)
+{
+    char *p;
+
+    snprintf (name, 1000, "%s/%s", path, D->_filename);
+    if ((p = strrchr (name, '.'))) *p = 0;
+    sprintf (name + strlen (name), "-%08x.ae1", key);
+}
+
+
 int Rankwave::save (const char *path, Addsynth *D, float fsamp, float fbase, float *scale)
 {
     FILE      *F;
@@ -457,11 +488,10 @@ int Rankwave::save (const char *path, Addsynth *D, float fsamp, float fbase, flo
     int        i;
     char       name [1024];
     char       data [64];
-    char      *p;
+    uint32_t   key;
 
-    sprintf (name, "%s/%s", path, D->_filename);
-    if ((p = strrchr (name, '.'))) strcpy (p, ".ae1");
-    else strcat (name, ".ae1");
+    key = cache_key (D, fsamp, fbase, scale);
+    cache_name (name, path, D, key);
 
     F = fopen (name, "wb");
     if (F == NULL)
@@ -476,10 +506,7 @@ int Rankwave::save (const char *path, Addsynth *D, float fsamp, float fbase, flo
     fwrite (data, 1, 16, F);
 
     memset (data, 0, 64);
-    data [0] = 0;
-    data [1] = 0;
-    data [2] = 0;
-    data [3] = 0;
+    memcpy (data, &key, sizeof (key));
     data [4] = _n0;
     data [5] = _n1;
     data [6] = 0;
@@ -505,12 +532,11 @@ int Rankwave::load (const char *path, Addsynth *D, float fsamp, float fbase, flo
     int        i;
     char       name [1024];
     char       data [64];
-    char      *p;
     float      f;
+    uint32_t   key, k;
 
-    sprintf (name, "%s/%s", path, D->_filename);
-    if ((p = strrchr (name, '.'))) strcpy (p, ".ae1");
-    else strcat (name, ".ae1");
+    key = cache_key (D, fsamp, fbase, scale);
+    cache_name (name, path, D, key);
 
     F = fopen (name, "rb");
     if (F == NULL)
@@ -541,6 +567,16 @@ int Rankwave::load (const char *path, Addsynth *D, float fsamp, float fbase, flo
     }
 
     fread (data, 1, 64, F);
+    memcpy (&k, data, sizeof (k));
+    if (k != key)
+    {
+#ifdef DEBUG
+	fprintf (stderr, "File '%s' was generated from different stop parameters\n", name);
+#endif
+        fclose (F);
+        return 1;
+    }
+
     if (_n0 != data [4] || _n1 != data [5])
     {
 #ifdef DEBUG
@@ -139,6 +139,9 @@ public:
     int  load (const char *path, Addsynth *D, float fsamp, float fbase, float *scale);
     bool modif (void) const { return _modif; }
 
+    static uint32_t cache_key (Addsynth *D, float fsamp, float fbase, float *scale);
+    static void cache_name (char *name, const char *path, Addsynth *D, uint32_t key);
+
     int  _cmask;  // used by division logic
     int  _nmask;  // used by division logic
 
@@ -259,6 +259,21 @@ bool ExportMidi::write(QIODevice* device, bool midiExpandRepeats, bool exportRPN
       pauseMap.calculate(cs);
       writeHeader();
 
+      //
+      // distribute the rendered events to their staves once,
+      // so every track only walks its own part of the event map
+      //
+      std::vector<std::vector<EventMap::const_iterator>> staffEvents(tracks.size());
+      for (auto i = events.cbegin(); i != events.cend(); ++i) {
+            const NPlayEvent& event = i->second;
+            int originatingStaff = event.getOriginatingStaff();
+            int discardStaff     = event.discard() - 1;
+            if (discardStaff >= 0 && discardStaff < int(staffEvents.size()) && discardStaff != originatingStaff && event.velo() > 0)
+                  staffEvents[discardStaff].push_back(i);
+            if (originatingStaff >= 0 && originatingStaff < int(staffEvents.size()))
+                  staffEvents[originatingStaff].push_back(i);
+            }
+
       int staffIdx = 0;
       for (auto &track: tracks) {
             Staff* staff = cs->staff(staffIdx);
@@ -319,7 +334,7 @@ bool ExportMidi::write(QIODevice* device, bool midiExpandRepeats, bool exportRPN
                               track.insert(0, ev);
                               }
 
-                        for (auto i = events.begin(); i != events.end(); ++i) {
+                        for (const auto& i : staffEvents[staffIdx]) {
                               const NPlayEvent& event = i->second;
 
                               if (event.isMuted())
@@ -67,26 +67,67 @@ MidiFile::MidiFile()
       sstatus          = 0;
       click            = 0;
       curPos           = 0;
+      rbuf             = 0;
+      rsize            = 0;
+      wp               = 0;
       }
 
 //---------------------------------------------------------
 //   write
+//    serialize all tracks into one pre-sized buffer and
+//    hand it to the device in a single write
 //    returns true on error
 //---------------------------------------------------------
 
 bool MidiFile::write(QIODevice* out)
       {
-      fp = out;
-      write("MThd", 4);
+      qint64 size = 14;             // MThd chunk
+      for (const auto &t: qAsConst(_tracks))
+            size += trackSizeBound(t);
+
+      QByteArray data(int(size), Qt::Uninitialized);
+      uchar* begin = reinterpret_cast<uchar*>(data.data());
+      wp = begin;
+
+      put("MThd", 4);
       writeLong(6);                 // header len
       writeShort(_format);          // format
       writeShort(_tracks.size());
       writeShort(_division);
-      for (const auto &t: qAsConst(_tracks)) {
-            if (writeTrack(t))
-                  return true;
+      for (const auto &t: qAsConst(_tracks))
+            writeTrack(t);
+
+      Q_ASSERT(wp - begin <= size);
+      data.truncate(int(wp - begin));
+      wp = 0;
+
+      fp = out;
+      return write(data.constData(), data.size());
+      }
+
+//---------------------------------------------------------
+//   trackSizeBound
+//    upper limit of the number of bytes writeTrack()
+//    produces for this track
+//---------------------------------------------------------
+
+qint64 MidiFile::trackSizeBound(const MidiTrack& t)
+      {
+      qint64 size = 8 + 4;          // MTrk chunk header + "End Of Track" meta
+      for (const auto& i : t.events()) {
+            const MidiEvent& e = i.second;
+            size += 5;              // tick delta
+            switch (e.type()) {
+                  case ME_META:
+                  case ME_SYSEX:
+                        size += 2 + 5 + e.len();
+                        break;
+                  default:
+                        size += 3;
+                        break;
+                  }
             }
-      return false;
+      return size;
       }
 
 //---------------------------------------------------------
@@ -136,14 +177,14 @@ void MidiFile::writeEvent(const MidiEvent& event)
                   put(ME_META);
                   put(event.metaType());
                   putvl(event.len());
-                  write(event.edata(), event.len());
+                  put(event.edata(), event.len());
                   resetRunningStatus();     // really ?!
                   break;
 
             case ME_SYSEX:
                   put(ME_SYSEX);
                   putvl(event.len() + 1);  // including 0xf7
-                  write(event.edata(), event.len());
+                  put(event.edata(), event.len());
                   put(ME_ENDSYSEX);
                   resetRunningStatus();
                   break;
@@ -154,15 +195,15 @@ void MidiFile::writeEvent(const MidiEvent& event)
 //   writeTrack
 //---------------------------------------------------------
 
-bool MidiFile::writeTrack(const MidiTrack &t)
+void MidiFile::writeTrack(const MidiTrack &t)
       {
-      write("MTrk", 4);
-      qint64 lenpos = fp->pos();
+      put("MTrk", 4);
+      uchar* lenpos = wp;
       writeLong(0);                 // dummy len
 
       status   = -1;
       int tick = 0;
-      for (auto i : t.events()) {
+      for (const auto& i : t.events()) {
             int ntick = i.first;
             putvl(ntick - tick);    // write tick delta
             //
@@ -183,11 +224,10 @@ bool MidiFile::writeTrack(const MidiTrack &t)
       put(0xff);        // Meta
       put(0x2f);        // EOT
       putvl(0);         // len 0
-      qint64 endpos = fp->pos();
-      fp->seek(lenpos);
-      writeLong(endpos-lenpos-4);   // tracklen
-      fp->seek(endpos);
-      return false;
+      uchar* endpos = wp;
+      wp = lenpos;
+      writeLong(int(endpos - lenpos - 4));   // tracklen
+      wp = endpos;
       }
 
 //---------------------------------------------------------
@@ -212,8 +252,20 @@ void MidiFile::writeStatus(int nstat, int c)
 //---------------------------------------------------------
 
 bool MidiFile::read(QIODevice* in)
+      {
+      return read(in->readAll());
+      }
+
+//---------------------------------------------------------
+//   readMidi
+//    parse the file directly from memory
+//    return false on error
+//---------------------------------------------------------
+
+bool MidiFile::read(const QByteArray& data)
      {
-      fp = in;
+      rbuf  = reinterpret_cast<const uchar*>(data.constData());
+      rsize = data.size();
       _tracks.clear();
       curPos    = 0;
 
@@ -265,9 +317,9 @@ bool MidiFile::read(QIODevice* in)
       //  +-------+---+-------------------+-----------------+
 
       char firstByte;
-      fp->getChar(&firstByte);
+      read(&firstByte, 1);
       char secondByte;
-      fp->getChar(&secondByte);
+      read(&secondByte, 1);
       const char topBit = (firstByte & 0x80) >> 7;
 
       if (topBit == 0) {            // ticks per beat
@@ -286,24 +338,31 @@ bool MidiFile::read(QIODevice* in)
 
       // =====================================================
 
+      bool ok = true;
       switch (_format) {
             case 0:
                   if (readTrack())
-                        return false;
+                        ok = false;
                   break;
             case 1:
                   for (int i = 0; i < ntracks; i++) {
-                        if (readTrack())
-                              return false;
+                        if (readTrack()) {
+                              ok = false;
+                              break;
+                              }
                         }
                   break;
             default:
+                  rbuf  = 0;
+                  rsize = 0;
                   throw(QString("midi file format %1 not implemented").arg(_format));
 
                   // Prevent "unreachable code" warning 
                   // return false;
             }
-      return true;
+      rbuf  = 0;
+      rsize = 0;
+      return ok;
       }
 
 //---------------------------------------------------------
@@ -325,8 +384,9 @@ bool MidiFile::readTrack()
       _tracks.push_back(MidiTrack());
 
       int port = 0;
-      _tracks.back().setOutPort(port);
-      _tracks.back().setOutChannel(-1);
+      MidiTrack& track = _tracks.back();
+      track.setOutPort(port);
+      track.setOutChannel(-1);
 
       for (;;) {
             MidiEvent event;
@@ -336,7 +396,8 @@ bool MidiFile::readTrack()
             // check for end of track:
             if ((event.type() == ME_META) && (event.metaType() == META_EOT))
                   break;
-            _tracks.back().insert(click, event);
+            // events come in tick order: append instead of searching the insert position
+            track.events().emplace_hint(track.events().end(), click, event);
             }
       if (curPos != endPos) {
             qWarning("bad track len: %lld != %lld, %lld bytes too much\n", endPos, curPos, endPos - curPos);
@@ -355,10 +416,10 @@ bool MidiFile::readTrack()
 
 void MidiFile::read(void* p, qint64 len)
       {
-      curPos += len;
-      qint64 rv = fp->read((char*)p, len);
-      if (rv != len)
+      if (len < 0 || curPos + len > rsize)
             throw(QString("bad midifile: unexpected EOF"));
+      memcpy(p, rbuf + curPos, len);
+      curPos += len;
       }
 
 //---------------------------------------------------------
@@ -380,14 +441,21 @@ bool MidiFile::write(const void* p, qint64 len)
 
 int MidiFile::readShort()
       {
-      char c;
-      int val = 0;
-      for (int i = 0; i < 2; ++i) {
-            fp->getChar(&c);
-            val <<= 8;
-            val += (c & 0xff);
-            }
-      return val;
+      uchar c[2];
+      read(c, 2);
+      return (c[0] << 8) | c[1];
+      }
+
+//---------------------------------------------------------
+//   put
+//---------------------------------------------------------
+
+void MidiFile::put(const void* p, int len)
+      {
+      if (len <= 0)
+            return;
+      memcpy(wp, p, len);
+      wp += len;
       }
 
 //---------------------------------------------------------
@@ -396,8 +464,8 @@ int MidiFile::readShort()
 
 void MidiFile::writeShort(int i)
       {
-      fp->putChar(i >> 8);
-      fp->putChar(i);
+      put(i >> 8);
+      put(i);
       }
 
 //---------------------------------------------------------
@@ -407,14 +475,9 @@ void MidiFile::writeShort(int i)
 
 int MidiFile::readLong()
       {
-      char c;
-      int val = 0;
-      for (int i = 0; i < 4; ++i) {
-            fp->getChar(&c);
-            val <<= 8;
-            val += (c & 0xff);
-            }
-      return val;
+      uchar c[4];
+      read(c, 4);
+      return (c[0] << 24) | (c[1] << 16) | (c[2] << 8) | c[3];
       }
 
 //---------------------------------------------------------
@@ -423,37 +486,23 @@ int MidiFile::readLong()
 
 void MidiFile::writeLong(int i)
       {
-      fp->putChar(i >> 24);
-      fp->putChar(i >> 16);
-      fp->putChar(i >> 8);
-      fp->putChar(i);
+      put(i >> 24);
+      put(i >> 16);
+      put(i >> 8);
+      put(i);
       }
 
 /*---------------------------------------------------------
  *    skip
- *    This is meant for skipping a few bytes in a
- *    file or fifo.
  *---------------------------------------------------------*/
 
 void MidiFile::skip(qint64 len)
       {
-      // Note: if MS is updated to use Qt 5.10, this can be implemented with QIODevice::skip(), which should be more efficient
-      //       as bytes do not need to be moved around.
       if (len <= 0)
             return;
-#if (!defined (_MSCVER) && !defined (_MSC_VER))
-      char tmp[len];
-      read(tmp, len);
-#else
-      const int tmp_size = 256;  // Size of fixed-length temporary buffer. MSVC does not support VLA.
-      char tmp[tmp_size];
-      while(len > tmp_size) {
-            read(tmp, len);
-            len -= tmp_size;
-            }
-      // Now len is <= tmp_size, last read fits in the buffer.
-      read(tmp, tmp_size);
-#endif
+      if (curPos + len > rsize)
+            throw(QString("bad midifile: unexpected EOF"));
+      curPos += len;
       }
 
 /*---------------------------------------------------------
@@ -465,8 +514,9 @@ int MidiFile::getvl()
       {
       int l = 0;
       for (int i = 0; i < 16; i++) {
-            uchar c;
-            read(&c, 1);
+            if (curPos >= rsize)
+                  throw(QString("bad midifile: unexpected EOF"));
+            uchar c = rbuf[curPos++];
             l += (c & 0x7f);
             if (!(c & 0x80)) {
                   return l;
@@ -688,11 +738,16 @@ void MidiTrack::setOutChannel(int n)
 //    - find matching note on / note off events and merge
 //      into a note event with tick duration
 //    - find MIDI type
+//
+//    A note off ends the earliest still sounding note
+//    of the same pitch; notes are paired in one pass
+//    with a queue of sounding notes per pitch.
 //---------------------------------------------------------
 
 void MidiTrack::mergeNoteOnOffAndFindMidiType(MidiType *mt)
       {
       std::multimap<int, MidiEvent> el;
+      std::deque<std::multimap<int, MidiEvent>::iterator> sounding[128];
 
       int hbank = 0xff;
       int lbank = 0xff;
@@ -853,37 +908,32 @@ void MidiTrack::mergeNoteOnOffAndFindMidiType(MidiType *mt)
                   continue;
                   }
             int tick = i->first;
+            auto& queue = sounding[ev.pitch() & 0x7f];
             if (ev.type() == ME_NOTEOFF || ev.velo() == 0) {
-                  qDebug("-extra note off at %d", tick);
-                  ev.setType(ME_INVALID);
-                  continue;
-                  }
-            MidiEvent note(ME_NOTE, ev.channel(), ev.dataA(), ev.dataB());
-
-            auto k = i;
-            ++k;
-            for (; k != _events.end(); ++k) {
-                  MidiEvent& e = k->second;
-                  if (e.type() != ME_NOTEON && e.type() != ME_NOTEOFF)
-                        continue;
-                  if ((e.type() == ME_NOTEOFF || (e.type() == ME_NOTEON && e.velo() == 0))
-                     && (e.pitch() == note.pitch())) {
-                        int t = k->first - tick;
+                  if (queue.empty()) {
+                        qDebug("-extra note off at %d", tick);
+                        }
+                  else {
+                        auto note = queue.front();
+                        queue.pop_front();
+                        int t = tick - note->first;
                         if (t <= 0)
                               t = 1;
-                        note.setLen(t);
-                        e.setType(ME_INVALID);
-                        break;
+                        note->second.setLen(t);
                         }
+                  ev.setType(ME_INVALID);
+                  continue;
                   }
-            if (k == _events.end()) {
-                  qDebug("-no note-off for note at %d", tick);
-                  note.setLen(1);
-                  }
-            el.insert(std::pair<int,MidiEvent>(tick, note));
+            MidiEvent note(ME_NOTE, ev.channel(), ev.dataA(), ev.dataB());
+            note.setLen(1);
+            queue.push_back(el.insert(std::pair<int,MidiEvent>(tick, note)));
             ev.setType(ME_INVALID);
             }
-      _events = el;
+      for (const auto& queue : sounding) {
+            for (const auto& note : queue)
+                  qDebug("-no note-off for note at %d", note->first);
+            }
+      _events.swap(el);
       }
 
 //---------------------------------------------------------
@@ -81,17 +81,24 @@ class MidiFile {
       int sstatus;               ///< running status (not reset after meta or sysex events)
       int click;                 ///< current tick position in file
       qint64 curPos;             ///< current file byte position
+      const uchar* rbuf;         ///< file data being parsed
+      qint64 rsize;              ///< size of the file data
+
+      // values used during write()
+      uchar* wp;                 ///< current position in the output buffer
 
       void writeEvent(const MidiEvent& event);
+      static qint64 trackSizeBound(const MidiTrack&);
 
    protected:
       // write
       bool write(const void*, qint64);
       void writeShort(int);
       void writeLong(int);
-      bool writeTrack(const MidiTrack &);
+      void writeTrack(const MidiTrack &);
       void putvl(unsigned);
-      void put(unsigned char c) { write(&c, 1); }
+      void put(unsigned char c) { *wp++ = c; }
+      void put(const void*, int);
       void writeStatus(int type, int channel);
 
       // read
@@ -108,6 +115,7 @@ class MidiFile {
    public:
       MidiFile();
       bool read(QIODevice*);
+      bool read(const QByteArray&);
       bool write(QIODevice*);
       void readXml(XmlReader&);
 
@@ -606,7 +606,7 @@ int GuitarPro4::convertGP4SlideNum(int sl)
 //   read
 //---------------------------------------------------------
 
-bool GuitarPro4::read(QFile* fp)
+bool GuitarPro4::read(QIODevice* fp)
       {
       f      = fp;
       curPos = 30;
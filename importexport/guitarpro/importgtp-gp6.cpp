@@ -218,100 +218,124 @@ const std::map<QString, QString> GuitarPro6::instrumentMapping = {
             };
 
 //---------------------------------------------------------
-//   readBit
+//   GpxBitReader
+//    reads the bit stream of a BCFZ file most significant
+//    bit first, refilling a 64 bit buffer a word at a time
+//    bits past the end of the data read as 0
 //---------------------------------------------------------
 
-int GuitarPro6::readBit(QByteArray* buffer)
-      {
-      // calculate the byte index by dividing the position in bits by the bits per byte
-      int byteIndex = position / BITS_IN_BYTE;
-
-      // calculate our offset so we know how much to bit shift
-      int byteOffset = ((BITS_IN_BYTE - 1) - (position % BITS_IN_BYTE));
+class GpxBitReader {
+      const uchar* _data;
+      qint64 _size;
+      qint64 _next;                 // next byte to load into _bits
+      quint64 _bits    { 0 };      // pending bits, left aligned
+      int _count       { 0 };      // number of pending bits
+      qint64 _bitsRead { 0 };
 
-      // calculate the bit which we want to read
-      int bit = ((((*buffer)[byteIndex] & 0xff) >> byteOffset) & 0x01);
+      void refill();
 
-      // increment our current position so we know this bit has been read
-      position++;
-      return bit;       // return the bit we calculated
-      }
+   public:
+      GpxBitReader(const QByteArray& data, int offset)
+         : _data(reinterpret_cast<const uchar*>(data.constData())), _size(data.size()), _next(offset), _bitsRead(qint64(offset) * 8) {}
+      unsigned read(int n);
+      unsigned readReversed(int n);
+      qint64 bitsRead() const { return _bitsRead; }
+      };
 
 //---------------------------------------------------------
-//   readBits
+//   refill
+//    top up _bits to at least 56 pending bits
 //---------------------------------------------------------
 
-int GuitarPro6::readBits(QByteArray* buffer, int bitsToRead)
+void GpxBitReader::refill()
       {
-      int bits = 0;
-      for (int i = (bitsToRead - 1); i >= 0; i--)
-            bits |= (readBit(buffer) << i);
-      return bits;
+      if (_next + 8 <= _size) {
+            // load the next 8 bytes at once, the bytes that do not fit
+            // are loaded again by the next refill
+            quint64 word = 0;
+            for (int i = 0; i < 8; ++i)
+                  word = (word << 8) | _data[_next + i];
+            _bits  |= word >> _count;
+            _next  += (63 - _count) >> 3;
+            _count |= 56;
+            }
+      else {
+            while (_count <= 56) {
+                  const quint64 byte = _next < _size ? _data[_next] : 0;
+                  ++_next;
+                  _bits  |= byte << (56 - _count);
+                  _count += 8;
+                  }
+            }
       }
 
 //---------------------------------------------------------
-//   readBitsReversed
+//   read
+//    read n <= 32 bits, the first bit read is the most
+//    significant one
 //---------------------------------------------------------
 
-int GuitarPro6::readBitsReversed(QByteArray* buffer, int bitsToRead)
+unsigned GpxBitReader::read(int n)
       {
-      int bits = 0;
-      for( int i = 0; i < bitsToRead; i++)
-            bits |= readBit(buffer) << i;
+      if (n == 0)
+            return 0;
+      if (_count < n)
+            refill();
+      const unsigned bits = unsigned(_bits >> (64 - n));
+      _bits     <<= n;
+      _count    -= n;
+      _bitsRead += n;
       return bits;
       }
 
 //---------------------------------------------------------
-//   getBytes
+//   readReversed
+//    read n <= 32 bits, the first bit read is the least
+//    significant one
 //---------------------------------------------------------
 
-QByteArray GuitarPro6::getBytes(QByteArray* buffer, int offset, int length)
+unsigned GpxBitReader::readReversed(int n)
       {
-      QByteArray newBytes;
-      // compute new bytes from our buffer and return byte array
-      for (int i = 0; i < length; i++) {
-            if (buffer->length() > offset + i)
-                  newBytes.insert(i, ((*buffer)[offset + i]));
+      unsigned bits     = read(n);
+      unsigned reversed = 0;
+      for (int i = 0; i < n; ++i) {
+            reversed = (reversed << 1) | (bits & 1);
+            bits >>= 1;
             }
-      return newBytes;
+      return reversed;
       }
 
 //---------------------------------------------------------
 //   readInteger
+//    read a little endian integer, bytes past the end of
+//    the buffer read as 0
 //---------------------------------------------------------
 
-int GuitarPro6::readInteger(QByteArray* buffer, int offset)
+int GuitarPro6::readInteger(const QByteArray& buffer, qint64 offset)
       {
-      // assign four bytes and take them from the buffer
-      char bytes[4];
-      bytes[0] = (*buffer)[offset + 0];
-      bytes[1] = (*buffer)[offset + 1];
-      bytes[2] = (*buffer)[offset + 2];
-      bytes[3] = (*buffer)[offset + 3];
-      // increment positioning so we keep track of where we are
-      position += sizeof(int) * BITS_IN_BYTE;
-      // bit shift in order to compute our integer value and return
-      return ((bytes[3] & 0xff) << 24) | ((bytes[2] & 0xff) << 16) | ((bytes[1] & 0xff) << 8) | (bytes[0] & 0xff);
+      const uchar* data = reinterpret_cast<const uchar*>(buffer.constData());
+      quint32 value = 0;
+      for (int i = 3; i >= 0; --i) {
+            const qint64 idx = offset + i;
+            value = (value << 8) | (idx >= 0 && idx < buffer.size() ? data[idx] : 0);
+            }
+      return int(value);
       }
 
 //---------------------------------------------------------
 //   readString
+//    read a 0 terminated string of at most length bytes
 //---------------------------------------------------------
 
-QByteArray GuitarPro6::readString(QByteArray* buffer, int offset, int length)
+QByteArray GuitarPro6::readString(const QByteArray& buffer, qint64 offset, int length)
       {
-      QByteArray filename;
-      // compute the string by iterating through the buffer
-      for (int i = 0; i < length; i++) {
-            int charValue = (((*buffer)[offset + i]) & 0xff);
-            if (charValue == 0)
-                  break;
-            filename.push_back((char)charValue);
-            }
-      return filename;
+      if (offset < 0 || offset >= buffer.size())
+            return QByteArray();
+      const char* str = buffer.constData() + offset;
+      const int n     = int(qMin(qint64(length), buffer.size() - offset));
+      return QByteArray(str, int(qstrnlen(str, uint(n))));
       }
 
-
 //---------------------------------------------------------
 //   unhandledNode
 //---------------------------------------------------------
@@ -590,17 +614,30 @@ void GuitarPro6::readTrackProperties(const QDomNode& currentNode, Part* part, in
 //   getNode
 //---------------------------------------------------------
 
-QDomNode GuitarPro6::getNode(const QString& id, QDomNode currentDomNode)
+QDomNode GuitarPro6::getNode(const QString& id, const GPNodeIndex& index)
       {
-      while (!(currentDomNode).isNull()) {
-            QString currentId = currentDomNode.attributes().namedItem("id").toAttr().value();
-            if (id.compare(currentId) == 0) {
-                  return currentDomNode;
-                  }
-            currentDomNode = currentDomNode.nextSibling();
+      const QDomNode node = index.value(id);
+      if (node.isNull())
+            qDebug() << "WARNING: A null node was returned when search for the identifier" << id << ". Your Guitar Pro file may be corrupted.";
+      return node;
+      }
+
+//---------------------------------------------------------
+//   indexNodes
+//    index the children of list by their id attribute
+//    in one pass, the first of equal ids is kept as
+//    getNode() would find it first
+//---------------------------------------------------------
+
+GuitarPro6::GPNodeIndex GuitarPro6::indexNodes(const QDomNode& list)
+      {
+      GPNodeIndex index;
+      for (QDomNode node = list.firstChild(); !node.isNull(); node = node.nextSibling()) {
+            const QString id = node.attributes().namedItem("id").toAttr().value();
+            if (!index.contains(id))
+                  index.insert(id, node);
             }
-      qDebug() << "WARNING: A null node was returned when search for the identifier" << id << ". Your Guitar Pro file may be corrupted.";
-      return currentDomNode;
+      return index;
       }
 
 //---------------------------------------------------------
@@ -2475,11 +2512,11 @@ void GuitarPro6::readGpif(QByteArray* data)
 
       // set up the partInfo struct to contain information from the file
       partInfo.masterBars = masterBars.firstChild();
-      partInfo.bars       = b.firstChild();
-      partInfo.voices     = voices.firstChild();
-      partInfo.beats      = beats.firstChild();
-      partInfo.notes      = notes.firstChild();
-      partInfo.rhythms    = rhythms.firstChild();
+      partInfo.bars       = indexNodes(b);
+      partInfo.voices     = indexNodes(voices);
+      partInfo.beats      = indexNodes(beats);
+      partInfo.notes      = indexNodes(notes);
+      partInfo.rhythms    = indexNodes(rhythms);
 
       measures = findNumMeasures(&partInfo);
 
@@ -2585,71 +2622,122 @@ void GuitarPro6::parseFile(const char* filename, QByteArray* data)
 void GuitarPro6::readGPX(QByteArray* buffer)
       {
       // start by reading the file header. It will tell us if the byte array is compressed.
-      int fileHeader = readInteger(buffer, 0);
+      int fileHeader = readInteger(*buffer, 0);
 
       if (fileHeader == GPX_HEADER_COMPRESSED) {
-            // this is  a compressed file.
-            int length             = readInteger(buffer, position / BITS_IN_BYTE);
-            QByteArray* bcfsBuffer = new QByteArray();
-            int positionCounter    = 0;
-            while(!f->error() && (position / BITS_IN_BYTE) < length) {
-                  // read the bit indicating compression information
-                  int flag = readBits(buffer, 1);
-
-                  if (flag) {
-                        int bits = readBits(buffer, 4);
-                        int offs = readBitsReversed(buffer, bits);
-                        int size = readBitsReversed(buffer, bits);
-
-                        QByteArray bcfsBufferCopy = *bcfsBuffer;
-                        int pos                   = (bcfsBufferCopy.length() - offs);
-                        for( int i = 0; i < (size > offs ? offs : size); i++ ) {
-                              bcfsBuffer->insert(positionCounter, bcfsBufferCopy[pos + i] );
-                              positionCounter++;
-                              }
-                        }
-                  else {
-                        int size = readBitsReversed(buffer, 2);
-                        for(int i = 0; i < size; i++) {
-                              bcfsBuffer->insert(positionCounter, readBits(buffer, 8));
-                              positionCounter++;
-                              }
+            // recurse on the decompressed file stored as a byte array
+            QByteArray bcfsBuffer = decompressBCFZ(*buffer);
+            readGPX(&bcfsBuffer);
+            }
+      else if (fileHeader == GPX_HEADER_UNCOMPRESSED)
+            readBCFS(*buffer);
+      }
+
+//---------------------------------------------------------
+//   decompressBCFZ
+//    return the BCFS file a BCFZ file decompresses to
+//---------------------------------------------------------
+
+QByteArray GuitarPro6::decompressBCFZ(const QByteArray& buffer)
+      {
+      const int length = readInteger(buffer, 4);
+      GpxBitReader bits(buffer, 8);
+      // past the end of the buffer every chunk reads as an empty literal
+      const qint64 endBits = qint64(buffer.size()) * 8;
+
+      QByteArray bcfsBuffer;
+      bcfsBuffer.reserve(int(qBound(qint64(0), qint64(length), qint64(buffer.size()) * 64)));
+      while (!f->error() && bits.bitsRead() / 8 < length && bits.bitsRead() < endBits) {
+            // read the bit indicating compression information
+            if (bits.read(1)) {
+                  // a back reference into the bytes decompressed so far
+                  const int n    = int(bits.read(4));
+                  const int offs = int(bits.readReversed(n));
+                  const int size = qMin(int(bits.readReversed(n)), offs);
+                  if (size == 0)
+                        continue;
+                  const int len = bcfsBuffer.size();
+                  bcfsBuffer.resize(len + size);
+                  char* dst  = bcfsBuffer.data() + len;
+                  int from   = len - offs;
+                  int before = 0;         // bytes referenced before the start, read as 0
+                  if (from < 0) {
+                        before = qMin(-from, size);
+                        memset(dst, 0, before);
                         }
+                  // size <= offs, so the source ends before dst
+                  memcpy(dst + before, bcfsBuffer.constData() + from + before, size - before);
+                  }
+            else {
+                  // up to three literal bytes
+                  const int size = int(bits.readReversed(2));
+                  if (size == 0)
+                        continue;
+                  const unsigned literal = bits.read(size * 8);
+                  for (int i = size - 1; i >= 0; --i)
+                        bcfsBuffer.append(char(literal >> (8 * i)));
                   }
-            // recurse on the decompressed file stored as a byte array
-            readGPX(bcfsBuffer);
-            delete bcfsBuffer;
             }
-      else if (fileHeader == GPX_HEADER_UNCOMPRESSED) {
-            // this is an uncompressed file - strip the header off
-            *buffer = buffer->right(buffer->length() - sizeof(int));
-            int sectorSize = 0x1000;
-            int offset     = 0;
-            while ((offset = (offset + sectorSize)) + 3 < buffer->length()) {
-                  int newInt = readInteger(buffer,offset);
-                  if (newInt == 2) {
-                        int indexFileName = (offset + 4);
-                        int indexFileSize = (offset + 0x8C);
-                        int indexOfBlock  = (offset + 0x94);
-
-                        // create a byte array and put information about files found in it
-                        int block             = 0;
-                        int blockCount        = 0;
-                        QByteArray* fileBytes = new QByteArray();
-                        while((block = (readInteger(buffer, (indexOfBlock + (4 * (blockCount++)))))) != 0 ) {
-                              fileBytes->push_back(getBytes(buffer, (offset = (block * sectorSize)), sectorSize));
-                              }
-                        // get file information and read the file
-                        int fileSize = readInteger(buffer, indexFileSize);
-                        if (fileBytes->length() >= fileSize) {
-                              QByteArray filenameBytes = readString(buffer, indexFileName, 127);
-                              char* filename           = filenameBytes.data();
-                              QByteArray data          = getBytes(fileBytes, 0, fileSize);
-                              parseFile(filename, &data);
+      return bcfsBuffer;
+      }
+
+//---------------------------------------------------------
+//   readBCFS
+//    read the files of a BCFS file system
+//---------------------------------------------------------
+
+void GuitarPro6::readBCFS(const QByteArray& buffer)
+      {
+      // strip the header off, offsets are relative to the data
+      const QByteArray data   = QByteArray::fromRawData(buffer.constData() + sizeof(int), qMax(buffer.size() - int(sizeof(int)), 0));
+      const qint64 sectorSize = 0x1000;
+      qint64 offset           = 0;
+      while ((offset = (offset + sectorSize)) + 3 < data.size()) {
+            if (readInteger(data, offset) != 2)
+                  continue;
+            const qint64 indexFileName = offset + 4;
+            const qint64 indexFileSize = offset + 0x8C;
+            const qint64 indexOfBlock  = offset + 0x94;
+
+            // the file is stored in the sectors listed after its header, the
+            // sectors past the end of the data are cut short
+            auto sectorBytes = [&data, sectorSize](qint64 sector) {
+                  return sector < 0 ? qint64(0) : qBound(qint64(0), data.size() - sector, sectorSize);
+                  };
+            std::vector<qint64> sectors;
+            qint64 stored   = 0;
+            bool contiguous = true;
+            int block       = 0;
+            for (int blockCount = 0; (block = readInteger(data, indexOfBlock + 4 * blockCount)) != 0; ++blockCount) {
+                  offset = block * sectorSize;
+                  if (!sectors.empty() && offset != sectors.back() + sectorSize)
+                        contiguous = false;
+                  sectors.push_back(offset);
+                  stored += sectorBytes(offset);
+                  }
+
+            // get file information and read the file
+            const int fileSize = readInteger(data, indexFileSize);
+            if (stored < fileSize)
+                  continue;
+            const QByteArray filename = readString(data, indexFileName, 127);
+            QByteArray file;
+            if (fileSize > 0) {
+                  if (contiguous && sectors.front() >= 0 && sectors.front() + fileSize <= data.size())
+                        file = QByteArray::fromRawData(data.constData() + sectors.front(), fileSize);
+                  else {
+                        file.resize(fileSize);
+                        int copied = 0;
+                        for (qint64 sector : sectors) {
+                              const int n = int(qMin(sectorBytes(sector), qint64(fileSize - copied)));
+                              if (n > 0) {
+                                    memcpy(file.data() + copied, data.constData() + sector, n);
+                                    copied += n;
+                                    }
                               }
-                        delete fileBytes;
                         }
                   }
+            parseFile(filename.constData(), &file);
             }
       }
 
@@ -2667,7 +2755,7 @@ int GuitarPro6::readBeatEffects(int, Segment*)
 //   read
 //---------------------------------------------------------
 
-bool GuitarPro6::read(QFile* fp)
+bool GuitarPro6::read(QIODevice* fp)
       {
       f = fp;
       previousTempo = -1;
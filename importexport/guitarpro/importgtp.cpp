@@ -1046,7 +1046,7 @@ void GuitarPro::applyBeatEffects(Chord* chord, int beatEffect)
 //   read
 //---------------------------------------------------------
 
-bool GuitarPro1::read(QFile* fp)
+bool GuitarPro1::read(QIODevice* fp)
       {
       f      = fp;
       curPos = 30;
@@ -1423,7 +1423,7 @@ void GuitarPro::createOttava(bool hasOttava, int track, ChordRest* cr, QString v
 //   read
 //---------------------------------------------------------
 
-bool GuitarPro2::read(QFile* fp)
+bool GuitarPro2::read(QIODevice* fp)
       {
       f      = fp;
       curPos = 30;
@@ -2076,7 +2076,7 @@ int GuitarPro1::readBeatEffects(int, Segment*)
 //   read
 //---------------------------------------------------------
 
-bool GuitarPro3::read(QFile* fp)
+bool GuitarPro3::read(QIODevice* fp)
       {
       f      = fp;
       curPos = 30;
@@ -2712,8 +2712,20 @@ Score::FileError importGTP(MasterScore* score, const QString& name)
       QFile fp(name);
       if (!fp.exists())
             return Score::FileError::FILE_NOT_FOUND;
-      if (!fp.open(QIODevice::ReadOnly))
+      return importGTP(score, &fp, name);
+      }
+
+//---------------------------------------------------------
+//   importGTP
+//    read from an unopened device, the file type is
+//    taken from the suffix of name or the file header
+//---------------------------------------------------------
+
+Score::FileError importGTP(MasterScore* score, QIODevice* io, const QString& name)
+      {
+      if (!io->open(QIODevice::ReadOnly))
             return Score::FileError::FILE_OPEN_ERROR;
+      QIODevice& fp = *io;
 
       char header[5];
       fp.read(header, 4);
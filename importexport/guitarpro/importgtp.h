@@ -198,7 +198,7 @@ class GuitarPro {
       std::vector<Ottava*> ottava;
       Hairpin** hairpins;
       MasterScore* score;
-      QFile* f;
+      QIODevice* f;
       int curPos;
       int previousTempo;
       int previousDynamic;
@@ -274,7 +274,7 @@ class GuitarPro {
 
       GuitarPro(MasterScore*, int v);
       virtual ~GuitarPro();
-      virtual bool read(QFile*) = 0;
+      virtual bool read(QIODevice*) = 0;
       QString error(GuitarProError n) const { return QString(errmsg[int(n)]); }
       };
 
@@ -290,7 +290,7 @@ class GuitarPro1 : public GuitarPro {
 
    public:
       GuitarPro1(MasterScore* s, int v) : GuitarPro(s, v) {}
-      virtual bool read(QFile*);
+      virtual bool read(QIODevice*);
       };
 
 //---------------------------------------------------------
@@ -301,7 +301,7 @@ class GuitarPro2 : public GuitarPro1 {
 
    public:
       GuitarPro2(MasterScore* s, int v) : GuitarPro1(s, v) {}
-      virtual bool read(QFile*);
+      virtual bool read(QIODevice*);
       };
 
 //---------------------------------------------------------
@@ -313,7 +313,7 @@ class GuitarPro3 : public GuitarPro1 {
 
    public:
       GuitarPro3(MasterScore* s, int v) : GuitarPro1(s, v) {}
-      virtual bool read(QFile*);
+      virtual bool read(QIODevice*);
       };
 
 //---------------------------------------------------------
@@ -331,7 +331,7 @@ class GuitarPro4 : public GuitarPro {
 
    public:
       GuitarPro4(MasterScore* s, int v) : GuitarPro(s, v) {}
-      virtual bool read(QFile*);
+      virtual bool read(QIODevice*);
       };
 
 //---------------------------------------------------------
@@ -355,7 +355,7 @@ class GuitarPro5 : public GuitarPro {
 
    public:
       GuitarPro5(MasterScore* s, int v) : GuitarPro(s, v) {}
-      virtual bool read(QFile*);
+      virtual bool read(QIODevice*);
       };
 
 //---------------------------------------------------------
@@ -370,29 +370,26 @@ class GuitarPro6 : public GuitarPro {
       const int GPX_HEADER_UNCOMPRESSED = 1397113666;
       // an integer stored in the header indicating that the file is not compressed (BCFZ).
       const int GPX_HEADER_COMPRESSED = 1514554178;
-      int position = 0;
-      // a constant storing the amount of bits per byte
-      const int BITS_IN_BYTE = 8;
+      // the elements of a gpif list (Bars, Voices, ...) by their id attribute
+      typedef QHash<QString, QDomNode> GPNodeIndex;
       // contains all the information about notes that will go in the parts
       struct GPPartInfo {
             QDomNode masterBars;
-            QDomNode bars;
-            QDomNode voices;
-            QDomNode beats;
-            QDomNode notes;
-            QDomNode rhythms;
+            GPNodeIndex bars;
+            GPNodeIndex voices;
+            GPNodeIndex beats;
+            GPNodeIndex notes;
+            GPNodeIndex rhythms;
             };
       Slur** legatos;
       // a mapping from identifiers to fret diagrams
       QMap<int, FretDiagram*> fretDiagrams;
       void parseFile(const char* filename, QByteArray* data);
-      int readBit(QByteArray* buffer);
-      QByteArray getBytes(QByteArray* buffer, int offset, int length);
       void readGPX(QByteArray* buffer);
-      int readInteger(QByteArray* buffer, int offset);
-      QByteArray readString(QByteArray* buffer, int offset, int length);
-      int readBits(QByteArray* buffer, int bitsToRead);
-      int readBitsReversed(QByteArray* buffer, int bitsToRead);
+      QByteArray decompressBCFZ(const QByteArray& buffer);
+      void readBCFS(const QByteArray& buffer);
+      static int readInteger(const QByteArray& buffer, qint64 offset);
+      static QByteArray readString(const QByteArray& buffer, qint64 offset, int length);
       void readScore(QDomNode* metadata);
       void readChord(QDomNode* diagram, int track);
       int findNumMeasures(GPPartInfo* partInfo);
@@ -404,7 +401,8 @@ class GuitarPro6 : public GuitarPro {
       void readMasterBars(GPPartInfo* partInfo);
       Fraction rhythmToDuration(QString value);
       Fraction fermataToFraction(int numerator, int denominator);
-      QDomNode getNode(const QString& id, QDomNode currentDomNode);
+      QDomNode getNode(const QString& id, const GPNodeIndex& index);
+      GPNodeIndex indexNodes(const QDomNode& list);
       void unhandledNode(QString nodeName);
       void makeTie(Note* note);
       void addTremoloBar(Segment* segment, int track, int whammyOrigin, int whammyMiddle, int whammyEnd);
@@ -422,7 +420,7 @@ class GuitarPro6 : public GuitarPro {
    public:
       GuitarPro6(MasterScore* s) : GuitarPro(s, 6) {}
       GuitarPro6(MasterScore* s, int v) : GuitarPro(s, v) {}
-      virtual bool read(QFile*);
+      virtual bool read(QIODevice*);
       };
 
 class GuitarPro7 : public GuitarPro6 {
@@ -430,7 +428,7 @@ class GuitarPro7 : public GuitarPro6 {
 
    public:
       GuitarPro7(MasterScore* s) : GuitarPro6(s, 7) {}
-      virtual bool read(QFile*);
+      virtual bool read(QIODevice*);
       };
 
 } // namespace Ms
@@ -20,7 +20,7 @@ namespace Ms {
 class PalmMute;
 
 class PowerTab {
-            QFile*                  _file;
+            QIODevice*              _file;
             MasterScore*            score;
 
             bool              readBoolean();
@@ -352,7 +352,7 @@ class PowerTab {
             void addPalmMute(Chord*);
 
       public:
-            PowerTab(QFile* f, MasterScore* s) : _file(f), score(s) {}
+            PowerTab(QIODevice* f, MasterScore* s) : _file(f), score(s) {}
             Score::FileError read();
       };
 
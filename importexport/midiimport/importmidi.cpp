@@ -70,6 +70,28 @@ namespace Ms {
 
 extern void updateNoteLines(Segment*, int track);
 
+//---------------------------------------------------------
+//   StageTimer
+//    debug output of the time spent in each stage
+//    of the MIDI import
+//---------------------------------------------------------
+
+class StageTimer {
+      QElapsedTimer _stage;
+      QElapsedTimer _total;
+
+   public:
+      StageTimer() { _stage.start(); _total.start(); }
+      void done(const char* stage)
+            {
+            qDebug("importMidi: %-32s %6lld ms", stage, _stage.restart());
+            }
+      void finished()
+            {
+            qDebug("importMidi: %-32s %6lld ms", "total", _total.elapsed());
+            }
+      };
+
 
 void lengthenTooShortNotes(std::multimap<int, MTrack> &tracks)
       {
@@ -217,6 +239,8 @@ void quantizeAllTracks(std::multimap<int, MTrack> &tracks,
                         // pass current track index through MidiImportOperations
                         // for further usage
             MidiOperations::CurrentTrackSetter setCurrentTrack{opers, mtrack.indexOfOperation};
+            QElapsedTimer timer;
+            timer.start();
 
             if (opers.data()->processingsOfOpenedFile == 0) {
                   opers.data()->trackOpers.isDrumTrack.setValue(
@@ -252,6 +276,9 @@ void quantizeAllTracks(std::multimap<int, MTrack> &tracks,
             Q_ASSERT_X(MidiTuplet::areTupletRangesOk(mtrack.chords, mtrack.tuplets),
                        "quantizeAllTracks", "Tuplet chord/note is outside tuplet "
                         "or non-tuplet chord/note is inside tuplet");
+
+            qDebug("importMidi:   quantize track %d: %zu chords, %zu tuplets, %lld ms",
+                   track.first, mtrack.chords.size(), mtrack.tuplets.size(), timer.elapsed());
             }
       }
 
@@ -1074,13 +1101,16 @@ QList<MTrack> convertMidi(Score *score, const MidiFile *mf)
       {
       auto *sigmap = score->sigmap();
 
+      StageTimer stages;
       auto tracks = createMTrackList(sigmap, mf);
+      stages.done("createMTrackList");
 
       auto &opers = midiImportOperations;
       if (opers.data()->processingsOfOpenedFile == 0)         // for newly opened MIDI file
             MidiChordName::findChordNames(tracks);
 
       lengthenTooShortNotes(tracks);
+      stages.done("findChordNames");
 
       if (opers.data()->processingsOfOpenedFile == 0) {       // for newly opened MIDI file
             opers.data()->trackCount = 0;
@@ -1096,6 +1126,7 @@ QList<MTrack> convertMidi(Score *score, const MidiFile *mf)
             Quantize::setIfHumanPerformance(tracks, sigmap);
       else        // user value
             MidiBeat::setTimeSignature(sigmap);
+      stages.done("beats");
 
       Q_ASSERT_X((opers.data()->trackOpers.isHumanPerformance.value())
                         ? Meter::userTimeSigToFraction(opers.data()->trackOpers.timeSigNumerator.value(),
@@ -1106,6 +1137,7 @@ QList<MTrack> convertMidi(Score *score, const MidiFile *mf)
       MChord::collectChords(tracks, {2, 1}, {1, 2});
       MidiBeat::adjustChordsToBeats(tracks);
       MChord::mergeChordsWithEqualOnTimeAndVoice(tracks);
+      stages.done("collectChords");
 
                   // for newly opened MIDI file
       if (opers.data()->processingsOfOpenedFile == 0
@@ -1121,8 +1153,10 @@ QList<MTrack> convertMidi(Score *score, const MidiFile *mf)
       LRHand::splitIntoLeftRightHands(tracks);
       MidiDrum::splitDrumVoices(tracks);
       MidiDrum::splitDrumTracks(tracks);
+      stages.done("splitHandsAndDrums");
       ReducedFraction lastTick = findLastChordTick(tracks);
       quantizeAllTracks(tracks, sigmap, lastTick);
+      stages.done("quantizeAllTracks");
       MChord::removeOverlappingNotes(tracks);
 
       Q_ASSERT_X(!doNotesOverlap(tracks),
@@ -1136,12 +1170,14 @@ QList<MTrack> convertMidi(Score *score, const MidiFile *mf)
             Simplify::simplifyDurationsNotDrums(tracks, sigmap);    // again
       Simplify::simplifyDurationsForDrums(tracks, sigmap);
       MChord::splitUnequalChords(tracks);
+      stages.done("simplifyAndSeparateVoices");
                   // no more track insertion/reordering/deletion from now
       QList<MTrack> trackList = prepareTrackList(tracks);
       MidiInstr::setGrandStaffProgram(trackList);
       MidiInstr::findInstrumentsForAllTracks(trackList);
       MidiInstr::createInstruments(score, trackList);
       MidiDrum::setStaffBracketForDrums(trackList);
+      stages.done("instruments");
 
       const auto firstTick = findFirstChordTick(trackList);
 
@@ -1151,6 +1187,7 @@ QList<MTrack> convertMidi(Score *score, const MidiFile *mf)
       createKeys(trackList);
       MidiKey::recognizeMainKeySig(trackList);
       createNotes(lastTick, trackList);
+      stages.done("createMeasuresAndNotes");
       processLyricMeta(trackList);
       applySwing(trackList);
       createClefs(trackList);
@@ -1160,6 +1197,8 @@ QList<MTrack> convertMidi(Score *score, const MidiFile *mf)
       MidiLyrics::setLyricsToScore(trackList);
       MidiTempo::setTempo(tracks, score);
       MidiChordName::setChordNames(trackList);
+      stages.done("clefsLyricsTempo");
+      stages.finished();
 
       return trackList;
       }
@@ -1174,6 +1213,17 @@ void loadMidiData(MidiFile &mf)
       }
 
 Score::FileError importMidi(MasterScore *score, const QString &name)
+      {
+      return importMidi(score, QByteArray(), name);
+      }
+
+//---------------------------------------------------------
+//   importMidi
+//    data holds the contents of the file name; if it is
+//    empty the file is read from disk when first opened
+//---------------------------------------------------------
+
+Score::FileError importMidi(MasterScore *score, const QByteArray &data, const QString &name)
       {
       if (name.isEmpty())
             return Score::FileError::FILE_NOT_FOUND;
@@ -1186,14 +1236,18 @@ Score::FileError importMidi(MasterScore *score, const QString &name)
 
       if (opers.data()->processingsOfOpenedFile == 0) {
 
-            QFile fp(name);
-            if (!fp.open(QIODevice::ReadOnly)) {
-                  qDebug("importMidi: file open error <%s>", qPrintable(name));
-                  return Score::FileError::FILE_OPEN_ERROR;
+            QByteArray fileData = data;
+            if (fileData.isEmpty()) {
+                  QFile fp(name);
+                  if (!fp.open(QIODevice::ReadOnly)) {
+                        qDebug("importMidi: file open error <%s>", qPrintable(name));
+                        return Score::FileError::FILE_OPEN_ERROR;
+                        }
+                  fileData = fp.readAll();
                   }
             MidiFile mf;
             try {
-                  mf.read(&fp);
+                  mf.read(fileData);
                   }
             catch (QString errorText) {
 #if 0
@@ -1204,16 +1258,15 @@ Score::FileError importMidi(MasterScore *score, const QString &name)
                            QString(), QWidget::tr("Quit"), QString(), 0, 1);
                         }
 #endif
-                  fp.close();
                   qDebug("importMidi: bad file format");
                   return Score::FileError::FILE_BAD_FORMAT;
                   }
-            fp.close();
 
             loadMidiData(mf);
             opers.setMidiFileData(name, mf);
             }
 
+      opers.data()->tupletSearchData = MidiOperations::TupletSearchData();
       opers.data()->tracks = convertMidi(score, opers.midiFile(name));
       ++opers.data()->processingsOfOpenedFile;
 
@@ -189,6 +189,17 @@ struct HumanBeatData
       bool measureCount2xLess = false;
       };
 
+// statistics of the tuplet search of the last import, see filterTuplets
+
+struct TupletSearchData
+      {
+      int searchedBars = 0;               // bars with tuplet candidates
+      int truncatedBars = 0;              // bars where the node limit was reached
+      size_t nodes = 0;                   // visited selection states
+      size_t maxBarNodes = 0;             // most states visited in one bar
+      size_t evaluated = 0;               // complete selections compared by their error
+      };
+
 struct FileData
       {
       MidiFile midiFile;
@@ -208,6 +219,7 @@ struct FileData
       QList<std::multimap<ReducedFraction, std::string>> lyricTracks;
       std::multimap<ReducedFraction, QString> chordNames;
       HumanBeatData humanBeatData;
+      TupletSearchData tupletSearchData;
       };
 
 class Data
@@ -4,6 +4,7 @@
 #include "importmidi_chord.h"
 #include "importmidi_quant.h"
 #include "importmidi_inner.h"
+#include "importmidi_operations.h"
 #include "libmscore/mscore.h"
 
 #include <set>
@@ -62,6 +63,26 @@ class TupletErrorResult
       size_t tupletCount;
       };
 
+// upper limit of the search nodes visited per bar:
+// the search is exhaustive below it, above it the best
+// selection found so far is used, so that dense unquantized
+// input cannot make the import hang on a single bar;
+// each node is a different selection of at most MAX_TUPLETS
+// (see removeExtraTuplets) candidates, so the limit binds only
+// for bars with many mutually compatible tuplets
+
+size_t maxTupletSearchNodes()
+      {
+      return 1 << 14;
+      }
+
+struct TupletSearchStats
+      {
+      size_t nodes = 0;             // visited selection states
+      size_t evaluated = 0;         // complete selections compared by their error
+      bool truncated = false;       // node limit was reached
+      };
+
 bool haveCommonChords(int i, int j, const std::vector<TupletInfo> &tuplets)
       {
       if (tuplets.empty())
@@ -432,11 +453,13 @@ bool validateSelectedTuplets(Iter beginIt,
 void tryUpdateBestIndexes(
             std::vector<int> &bestTupletIndexes,
             TupletErrorResult &minCurrentError,
+            TupletSearchStats &stats,
             const std::vector<int> &selectedTuplets,
             const std::vector<TupletInfo> &tuplets,
             const std::map<int, std::vector<std::pair<ReducedFraction, ReducedFraction>>> &voiceIntervals,
             const ReducedFraction &basicQuant)
       {
+      ++stats.evaluated;
       const size_t voiceCount = voiceIntervals.size();
       const auto error = findTupletError(selectedTuplets, tuplets,
                                          voiceCount, basicQuant);
@@ -534,6 +557,7 @@ void findNextTuplet(
             ValidTuplets &validTuplets,
             std::vector<int> &bestTupletIndexes,
             TupletErrorResult &minCurrentError,
+            TupletSearchStats &stats,
             const std::vector<TupletCommon> &tupletCommons,
             const std::vector<TupletInfo> &tuplets,
             const std::vector<std::pair<ReducedFraction, ReducedFraction> > &tupletIntervals,
@@ -541,6 +565,13 @@ void findNextTuplet(
             const ReducedFraction &basicQuant)
       {
       while (!validTuplets.empty()) {
+                        // keep the first complete selection at least
+            if (stats.nodes >= maxTupletSearchNodes() && minCurrentError.isInitialized()) {
+                  stats.truncated = true;
+                  return;
+                  }
+            ++stats.nodes;
+
             size_t index = validTuplets.first();
 
             bool isCommonGroupBegins = (selectedTuplets.empty() && index == commonsSize);
@@ -574,7 +605,7 @@ void findNextTuplet(
                               }
                         }
                   if (!canAddMoreIndexes) {
-                        tryUpdateBestIndexes(bestTupletIndexes, minCurrentError,
+                        tryUpdateBestIndexes(bestTupletIndexes, minCurrentError, stats,
                                              selectedTuplets, tuplets, voiceIntervals, basicQuant);
                         }
                   return;
@@ -610,13 +641,13 @@ void findNextTuplet(
                               }
                         }
                   if (!canAddMoreIndexes) {
-                        tryUpdateBestIndexes(bestTupletIndexes, minCurrentError,
+                        tryUpdateBestIndexes(bestTupletIndexes, minCurrentError, stats,
                                              selectedTuplets, tuplets, voiceIntervals, basicQuant);
                         }
                   }
             else {
                   findNextTuplet(selectedTuplets, validTuplets, bestTupletIndexes, minCurrentError,
-                                 tupletCommons, tuplets, tupletIntervals, commonsSize, basicQuant);
+                                 stats, tupletCommons, tuplets, tupletIntervals, commonsSize, basicQuant);
                   }
 
             selectedTuplets.pop_back();
@@ -645,7 +676,8 @@ std::vector<int> findBestTuplets(
             const std::vector<TupletCommon> &tupletCommons,
             const std::vector<TupletInfo> &tuplets,
             size_t commonsSize,
-            const ReducedFraction &basicQuant)
+            const ReducedFraction &basicQuant,
+            TupletSearchStats &stats)
       {
       std::vector<int> bestTupletIndexes;
       std::vector<int> selectedTuplets;
@@ -655,7 +687,7 @@ std::vector<int> findBestTuplets(
       ValidTuplets validTuplets(int(tuplets.size()));
 
       findNextTuplet(selectedTuplets, validTuplets, bestTupletIndexes, minCurrentError,
-                     tupletCommons, tuplets, tupletIntervals, commonsSize, basicQuant);
+                     stats, tupletCommons, tuplets, tupletIntervals, commonsSize, basicQuant);
 
       return bestTupletIndexes;
       }
@@ -704,6 +736,7 @@ void filterTuplets(std::vector<TupletInfo> &tuplets,
       Q_ASSERT_X(!areTupletChordsEmpty(tuplets),
                  "MIDI tuplets: filterTuplets", "Tuplet has no chords but it should");
 
+      const size_t candidateCount = tuplets.size();
       removeUselessTuplets(tuplets);
       removeExtraTuplets(tuplets);
 
@@ -720,8 +753,31 @@ void filterTuplets(std::vector<TupletInfo> &tuplets,
             }
       const auto tupletCommons = findTupletCommons(tuplets);
 
+      TupletSearchStats stats;
       const std::vector<int> bestIndexes = findBestTuplets(tupletCommons, tuplets,
-                                                           commonsSize, basicQuant);
+                                                           commonsSize, basicQuant, stats);
+
+      auto *data = midiImportOperations.data();
+      if (data) {
+            auto &searchData = data->tupletSearchData;
+            ++searchData.searchedBars;
+            if (stats.truncated)
+                  ++searchData.truncatedBars;
+            searchData.nodes += stats.nodes;
+            searchData.maxBarNodes = qMax(searchData.maxBarNodes, stats.nodes);
+            searchData.evaluated += stats.evaluated;
+            }
+      if (stats.truncated) {
+            ReducedFraction barOnTime = tuplets.front().onTime;
+            for (const auto &tuplet: tuplets) {
+                  if (tuplet.onTime < barOnTime)
+                        barOnTime = tuplet.onTime;
+                  }
+            qDebug("filterTuplets: tuplet search truncated for tuplets from %d/%d: "
+                   "%zu candidates, %zu searched (%zu overlapping), %zu chosen",
+                   barOnTime.numerator(), barOnTime.denominator(),
+                   candidateCount, tuplets.size(), commonsSize, bestIndexes.size());
+            }
 
       Q_ASSERT_X(validateSelectedTuplets(bestIndexes.begin(), bestIndexes.end(), tuplets),
                  "MIDI tuplets: filterTuplets", "Tuplets have common chords but they shouldn't");
@@ -29,6 +29,7 @@
 #include "importmxmllogger.h"
 #include "importmxmlpass1.h"
 #include "importmxmlpass2.h"
+#include "importmxmlreader.h"
 
 #include "mscore/preferences.h"
 
@@ -44,17 +45,22 @@ Score::FileError importMusicXMLfromBuffer(Score* score, const QString& /*name*/,
       //logger.setLoggingLevel(MxmlLogger::Level::MXML_INFO);
       //logger.setLoggingLevel(MxmlLogger::Level::MXML_TRACE); // also include tracing
 
-      // pass 1
+      // tokenize once, both passes replay the same tokens
       dev->seek(0);
+      MxmlTokens tokens;
+      tokens.read(dev);
+      if (tokens.hasError())
+            logger.logError(tokens.errorString());
+
+      // pass 1
       MusicXMLParserPass1 pass1(score, &logger);
-      Score::FileError res = pass1.parse(dev);
+      Score::FileError res = pass1.parse(tokens);
       if (res != Score::FileError::FILE_NO_ERROR)
             return res;
 
       // pass 2
-      dev->seek(0);
       MusicXMLParserPass2 pass2(score, pass1, &logger);
-      return pass2.parse(dev);
+      return pass2.parse(tokens);
       }
 
 } // namespace Ms
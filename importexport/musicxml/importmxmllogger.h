@@ -13,19 +13,19 @@
 #ifndef __IMPORTMXMLLOGGER_H__
 #define __IMPORTMXMLLOGGER_H__
 
-class QXmlStreamReader;
-
 namespace Ms {
 
+class MxmlReader;
+
 class MxmlLogger {
 public:
       enum class Level : char {
             MXML_TRACE, MXML_INFO, MXML_ERROR
             };
       MxmlLogger() {}
-      void logDebugTrace(const QString& trace, const QXmlStreamReader* const xmlreader = 0);
-      void logDebugInfo(const QString& info, const QXmlStreamReader* const xmlreader = 0);
-      void logError(const QString& error, const QXmlStreamReader* const xmlreader = 0);
+      void logDebugTrace(const QString& trace, const MxmlReader* const xmlreader = 0);
+      void logDebugInfo(const QString& info, const MxmlReader* const xmlreader = 0);
+      void logError(const QString& error, const MxmlReader* const xmlreader = 0);
       void setLoggingLevel(const Level level) { _level = level; }
 private:
       Level _level = Level::MXML_INFO;
@@ -534,7 +534,7 @@ static void updatePartWithInstrumentChange(Part* const part, const MusicXMLInstr
  - MusicXMLInstruments: instrument details from score-part and part
  */
 
-static void setPartInstruments(MxmlLogger* logger, const QXmlStreamReader* const xmlreader,
+static void setPartInstruments(MxmlLogger* logger, const MxmlReader* const xmlreader,
                                Part* part, const QString& partId,
                                Score* score,
                                const MusicXmlInstrList& instrList,
@@ -710,7 +710,7 @@ static QString decodeEntities( const QString& src )
  Read the next part of a MusicXML formatted string and convert to MuseScore internal encoding.
  */
 
-static QString nextPartOfFormattedString(QXmlStreamReader& e)
+static QString nextPartOfFormattedString(MxmlReader& e)
       {
       //QString lang       = e.attribute(QString("xml:lang"), "it");
       QString fontWeight = e.attributes().value("font-weight").toString();
@@ -778,7 +778,7 @@ static QString nextPartOfFormattedString(QXmlStreamReader& e)
  Add a single lyric to the score or delete it (if number too high)
  */
 
-static void addLyric(MxmlLogger* logger, const QXmlStreamReader* const xmlreader,
+static void addLyric(MxmlLogger* logger, const MxmlReader* const xmlreader,
                      ChordRest* cr, Lyrics* l, int lyricNo, MusicXmlLyricsExtend& extendedLyrics)
       {
       if (lyricNo > MAX_LYRICS) {
@@ -801,7 +801,7 @@ static void addLyric(MxmlLogger* logger, const QXmlStreamReader* const xmlreader
  Add a notes lyrics to the score
  */
 
-static void addLyrics(MxmlLogger* logger, const QXmlStreamReader* const xmlreader,
+static void addLyrics(MxmlLogger* logger, const MxmlReader* const xmlreader,
                       ChordRest* cr,
                       const QMap<int, Lyrics*>& numbrdLyrics,
                       const QSet<Lyrics*>& extLyrics,
@@ -1511,13 +1511,13 @@ void MusicXMLParserPass2::skipLogCurrElem()
 //---------------------------------------------------------
 
 /**
- Parse MusicXML in \a device and extract pass 2 data.
+ Parse the MusicXML in \a tokens and extract pass 2 data.
  */
 
-Score::FileError MusicXMLParserPass2::parse(QIODevice* device)
+Score::FileError MusicXMLParserPass2::parse(const MxmlTokens& tokens)
       {
       //qDebug("MusicXMLParserPass2::parse()");
-      _e.setDevice(device);
+      _e.setTokens(&tokens);
       Score::FileError res = parse();
       //qDebug("MusicXMLParserPass2::parse() res %d", int(res));
       return res;
@@ -2351,7 +2351,7 @@ void MusicXMLParserPass2::measureStyle(Measure* measure)
 //   calcTicks
 //---------------------------------------------------------
 
-static Fraction calcTicks(const QString& text, int divs, MxmlLogger* logger, const QXmlStreamReader* const xmlreader)
+static Fraction calcTicks(const QString& text, int divs, MxmlLogger* logger, const MxmlReader* const xmlreader)
       {
       Fraction dura(0, 0);              // invalid unless set correctly
 
@@ -4141,7 +4141,7 @@ static void addFiguredBassElemens(FiguredBassList& fbl, const Fraction noteStart
 static void addTremolo(ChordRest* cr,
                        const int tremoloNr, const QString& tremoloType,
                        Chord*& tremStart,
-                       MxmlLogger* logger, const QXmlStreamReader* const xmlreader,
+                       MxmlLogger* logger, const MxmlReader* const xmlreader,
                        Fraction& timeMod)
       {
       if (!cr->isChord())
@@ -5248,7 +5248,7 @@ void MusicXMLParserPass2::backup(Fraction& dura)
 //---------------------------------------------------------
 
 MusicXMLParserLyric::MusicXMLParserLyric(const LyricNumberHandler lyricNumberHandler,
-                                         QXmlStreamReader& e, Score* score, MxmlLogger* logger)
+                                         MxmlReader& e, Score* score, MxmlLogger* logger)
       : _lyricNumberHandler(lyricNumberHandler), _e(e), _score(score), _logger(logger)
       {
       // nothing
@@ -5386,7 +5386,7 @@ void MusicXMLParserNotations::slur()
 //---------------------------------------------------------
 
 static void addSlur(const Notation& notation, SlurStack& slurs, ChordRest* cr, const int tick,
-                    MxmlLogger* logger, const QXmlStreamReader* const xmlreader)
+                    MxmlLogger* logger, const MxmlReader* const xmlreader)
       {
       auto slurNo = notation.attribute("number").toInt();
       if (slurNo > 0) slurNo--;
@@ -5798,7 +5798,7 @@ void MusicXMLParserNotations::glissandoSlide()
 
 static void addGlissandoSlide(const Notation& notation, Note* note,
                               Glissando* glissandi[MAX_NUMBER_LEVEL][2], MusicXmlSpannerMap& spanners,
-                              MxmlLogger* logger, const QXmlStreamReader* const xmlreader)
+                              MxmlLogger* logger, const MxmlReader* const xmlreader)
       {
       auto glissandoNumber = notation.attribute("number").toInt();
       if (glissandoNumber > 0) glissandoNumber--;
@@ -5860,7 +5860,7 @@ static void addGlissandoSlide(const Notation& notation, Note* note,
 //---------------------------------------------------------
 
 static void addArpeggio(ChordRest* cr, const QString& arpeggioType,
-                        MxmlLogger* logger, const QXmlStreamReader* const xmlreader)
+                        MxmlLogger* logger, const MxmlReader* const xmlreader)
       {
       // no support for arpeggio on rest
       if (!arpeggioType.isEmpty() && cr->type() == ElementType::CHORD) {
@@ -5902,7 +5902,7 @@ static void addArticLaissezVibrer(const Note* const note)
 //---------------------------------------------------------
 
 static void addTie(const Notation& notation, Score* score, Note* note, const int track,
-                   Tie*& tie, MxmlLogger* logger, const QXmlStreamReader* const xmlreader)
+                   Tie*& tie, MxmlLogger* logger, const MxmlReader* const xmlreader)
       {
       Q_ASSERT(note);
       const QString& type = notation.attribute("type");
@@ -5953,7 +5953,7 @@ static void addTie(const Notation& notation, Score* score, Note* note, const int
 static void addWavyLine(ChordRest* cr, const Fraction& tick,
                         const int wavyLineNo, const QString& wavyLineType,
                         MusicXmlSpannerMap& spanners, TrillStack& trills,
-                        MxmlLogger* logger, const QXmlStreamReader* const xmlreader)
+                        MxmlLogger* logger, const MxmlReader* const xmlreader)
       {
       if (!wavyLineType.isEmpty()) {
             const auto ticks = cr->ticks();
@@ -6015,7 +6015,7 @@ static void addBreath(ChordRest* cr, const Fraction& tick, SymId breath)
 //---------------------------------------------------------
 
 static void addChordLine(const Notation& notation, Note* note,
-                         MxmlLogger* logger, const QXmlStreamReader* const xmlreader)
+                         MxmlLogger* logger, const MxmlReader* const xmlreader)
       {
       const QString& chordLineType = notation.subType();
       if (chordLineType != "") {
@@ -6044,12 +6044,12 @@ static void addChordLine(const Notation& notation, Note* note,
  Helper function to create Notation with initial attributes.
  */
 
-Notation Notation::notationWithAttributes(const QString& name, const QXmlStreamAttributes attributes,
+Notation Notation::notationWithAttributes(const QString& name, const MxmlAttributes& attributes,
                                           const QString& parent, const SymId& symId)
       {
       Notation notation { name, parent, symId };
-      for (const auto& attr : attributes) {
-            notation.addAttribute(attr.name(), attr.value());
+      for (int i = 0; i < attributes.size(); ++i) {
+            notation.addAttribute(attributes.name(i), attributes.value(i));
             }
       return notation;
       }
@@ -6099,7 +6099,7 @@ QString Notation::print() const
 //   MusicXMLParserNotations
 //---------------------------------------------------------
 
-MusicXMLParserNotations::MusicXMLParserNotations(QXmlStreamReader& e, Score* score, MxmlLogger* logger)
+MusicXMLParserNotations::MusicXMLParserNotations(MxmlReader& e, Score* score, MxmlLogger* logger)
       : _e(e), _score(score), _logger(logger)
       {
       // nothing
@@ -6411,7 +6411,7 @@ void MusicXMLParserNotations::tuplet()
  MusicXMLParserDirection constructor.
  */
 
-MusicXMLParserDirection::MusicXMLParserDirection(QXmlStreamReader& e,
+MusicXMLParserDirection::MusicXMLParserDirection(MxmlReader& e,
                                                  Score* score,
                                                  const MusicXMLParserPass1& pass1,
                                                  MusicXMLParserPass2& pass2,
@@ -0,0 +1,314 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  Copyright (C) 2020 Werner Schweer and others
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2
+//  as published by the Free Software Foundation and appearing in
+//  the file LICENCE.GPL
+//=============================================================================
+
+#include "importmxmlreader.h"
+
+namespace Ms {
+
+//---------------------------------------------------------
+//   read
+//---------------------------------------------------------
+
+/**
+ Tokenize the document in \a device. Element and attribute names are
+ stored once, tokens refer to them by id. Character data and attribute
+ values are stored as ranges of the decoded document; text that is not
+ in the document verbatim (entities, CDATA sections, normalized attribute
+ values) is appended to it. Documents that are not UTF-8 encoded are
+ not kept, all of their text is appended. If the document is not
+ well-formed, the tokens up to the error are kept and errorString() is set.
+ */
+
+void MxmlTokens::read(QIODevice* device)
+      {
+      _text.clear();
+      _tokens.clear();
+      _attributes.clear();
+      _names.clear();
+      _errorString.clear();
+
+      QMultiHash<uint, int> nameIndex;      // hash of a name -> id
+      auto intern = [this, &nameIndex](const QStringRef& name) {
+            const uint h = qHash(name);
+            for (auto i = nameIndex.constFind(h); i != nameIndex.constEnd() && i.key() == h; ++i) {
+                  if (_names[i.value()] == name)
+                        return i.value();
+                  }
+            const int id = _names.size();
+            _names.append(name.toString());
+            nameIndex.insert(h, id);
+            return id;
+            };
+
+      QByteArray data = device->readAll();
+      bool utf8 = !data.startsWith("\xFE\xFF") && !data.startsWith("\xFF\xFE");
+      if (utf8) {
+            QXmlStreamReader d(data);
+            if (d.readNext() == QXmlStreamReader::StartDocument) {
+                  const QStringRef encoding = d.documentEncoding();
+                  utf8 = encoding.isEmpty() || encoding.compare(QLatin1String("UTF-8"), Qt::CaseInsensitive) == 0;
+                  }
+            }
+      QXmlStreamReader e;
+      if (utf8) {
+            // character offsets of the reader are positions in _text
+            const int bom = data.startsWith("\xEF\xBB\xBF") ? 3 : 0;
+            _text = QString::fromUtf8(data.constData() + bom, data.size() - bom);
+            data.clear();
+            e.addData(_text);
+            }
+      else
+            e.addData(data);
+      const int documentLength = _text.size();
+
+      // set offset and length of s, found in the document between from and to
+      // (between quotes for an attribute value) or appended to it
+      auto store = [this, documentLength](const QStringRef& s, int from, int to, bool quoted, int& offset, int& length) {
+            length = s.size();
+            offset = 0;
+            if (length == 0)
+                  return;
+            if (to <= documentLength && from < to) {
+                  if (!quoted && to - from == length && QStringRef(&_text, from, length) == s) {
+                        offset = from;
+                        return;
+                        }
+                  const QStringRef range(&_text, from, to - from);
+                  for (int i = range.indexOf(s); i >= 0; i = range.indexOf(s, i + 1)) {
+                        const int pos = from + i;
+                        if (quoted) {
+                              if (pos == from || pos + length == to)
+                                    continue;
+                              const QChar quote = _text[pos - 1];
+                              if ((quote != '"' && quote != '\'') || _text[pos + length] != quote)
+                                    continue;
+                              }
+                        offset = pos;
+                        return;
+                        }
+                  }
+            offset = _text.size();
+            _text.append(s);
+            };
+
+      int start = 0;          // where the current token starts in _text
+      while (!e.atEnd()) {
+            const QXmlStreamReader::TokenType type = e.readNext();
+            if (type == QXmlStreamReader::Invalid)
+                  break;
+            const int end = int(e.characterOffset());
+            Token t { type, -1, 0, 0, int(e.lineNumber()), int(e.columnNumber()) };
+            if (type == QXmlStreamReader::StartElement) {
+                  t.name = intern(e.name());
+                  const QXmlStreamAttributes attrs = e.attributes();
+                  t.offset = _attributes.size();
+                  t.length = attrs.size();
+                  int pos = start;
+                  for (const QXmlStreamAttribute& a : attrs) {
+                        Attribute attr { intern(a.qualifiedName()), 0, 0 };
+                        store(a.value(), pos, end, true, attr.offset, attr.length);
+                        if (attr.offset < end)
+                              pos = qMax(pos, attr.offset + attr.length);
+                        _attributes.append(attr);
+                        }
+                  }
+            else if (type == QXmlStreamReader::EndElement)
+                  t.name = intern(e.name());
+            else if (type == QXmlStreamReader::Characters || type == QXmlStreamReader::EntityReference)
+                  store(e.text(), start, end, false, t.offset, t.length);
+            _tokens.append(t);
+            start = end;
+            }
+
+      if (e.hasError())
+            _errorString = QString("%1 at line %2 col %3").arg(e.errorString()).arg(e.lineNumber()).arg(e.columnNumber());
+      _text.squeeze();
+      _tokens.squeeze();
+      _attributes.squeeze();
+      }
+
+//---------------------------------------------------------
+//   indexOf
+//---------------------------------------------------------
+
+int MxmlAttributes::indexOf(const char* name) const
+      {
+      for (int i = 0; i < _size; ++i) {
+            if (_tokens->_names[at(i).name] == QLatin1String(name))
+                  return i;
+            }
+      return -1;
+      }
+
+//---------------------------------------------------------
+//   value
+//---------------------------------------------------------
+
+/**
+ Same as QXmlStreamAttributes::value().
+ */
+
+QStringRef MxmlAttributes::value(const char* name) const
+      {
+      const int i = indexOf(name);
+      return i < 0 ? QStringRef() : value(i);
+      }
+
+//---------------------------------------------------------
+//   setTokens
+//---------------------------------------------------------
+
+/**
+ Start replaying \a tokens from the beginning.
+ */
+
+void MxmlReader::setTokens(const MxmlTokens* tokens)
+      {
+      _tokens = tokens;
+      _pos    = -1;
+      _error  = false;
+      }
+
+//---------------------------------------------------------
+//   readNext
+//---------------------------------------------------------
+
+QXmlStreamReader::TokenType MxmlReader::readNext()
+      {
+      if (atEnd())
+            return QXmlStreamReader::Invalid;
+      ++_pos;
+      if (_pos >= _tokens->size() && _tokens->hasError())
+            _error = true;            // the document ended early, as QXmlStreamReader would report
+      return tokenType();
+      }
+
+//---------------------------------------------------------
+//   readNextStartElement
+//---------------------------------------------------------
+
+/**
+ Same as QXmlStreamReader::readNextStartElement().
+ */
+
+bool MxmlReader::readNextStartElement()
+      {
+      while (readNext() != QXmlStreamReader::Invalid) {
+            if (isEndElement())
+                  return false;
+            else if (isStartElement())
+                  return true;
+            }
+      return false;
+      }
+
+//---------------------------------------------------------
+//   skipCurrentElement
+//---------------------------------------------------------
+
+/**
+ Same as QXmlStreamReader::skipCurrentElement().
+ */
+
+void MxmlReader::skipCurrentElement()
+      {
+      int depth = 1;
+      while (depth && readNext() != QXmlStreamReader::Invalid) {
+            if (isEndElement())
+                  --depth;
+            else if (isStartElement())
+                  ++depth;
+            }
+      }
+
+//---------------------------------------------------------
+//   readElementText
+//---------------------------------------------------------
+
+/**
+ Same as QXmlStreamReader::readElementText() with the default
+ QXmlStreamReader::ErrorOnUnexpectedElement behavior: a child
+ element stops the replay.
+ */
+
+QString MxmlReader::readElementText()
+      {
+      if (!isStartElement())
+            return QString();
+
+      QString result;
+      for (;;) {
+            switch (readNext()) {
+                  case QXmlStreamReader::Characters:
+                  case QXmlStreamReader::EntityReference:
+                        result += text();
+                        break;
+                  case QXmlStreamReader::EndElement:
+                        return result;
+                  case QXmlStreamReader::ProcessingInstruction:
+                  case QXmlStreamReader::Comment:
+                        break;
+                  default:
+                        if (!atEnd())
+                              _error = true;
+                        return result;
+                  }
+            }
+      }
+
+//---------------------------------------------------------
+//   tokenString
+//---------------------------------------------------------
+
+QString MxmlReader::tokenString() const
+      {
+      static const char* const names[] = {
+            "NoToken", "Invalid", "StartDocument", "EndDocument", "StartElement", "EndElement",
+            "Characters", "Comment", "DTD", "EntityReference", "ProcessingInstruction"
+            };
+      return QLatin1String(names[int(tokenType())]);
+      }
+
+//---------------------------------------------------------
+//   name
+//---------------------------------------------------------
+
+QStringRef MxmlReader::name() const
+      {
+      if (!valid() || token().name < 0)
+            return QStringRef();
+      return QStringRef(&_tokens->_names[token().name]);
+      }
+
+//---------------------------------------------------------
+//   text
+//---------------------------------------------------------
+
+QStringRef MxmlReader::text() const
+      {
+      if (tokenType() != QXmlStreamReader::Characters && tokenType() != QXmlStreamReader::EntityReference)
+            return QStringRef();
+      return QStringRef(&_tokens->_text, token().offset, token().length);
+      }
+
+//---------------------------------------------------------
+//   attributes
+//---------------------------------------------------------
+
+MxmlAttributes MxmlReader::attributes() const
+      {
+      if (!isStartElement())
+            return MxmlAttributes();
+      return MxmlAttributes(_tokens, token().offset, token().length);
+      }
+
+} // namespace Ms
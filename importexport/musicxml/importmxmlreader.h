@@ -0,0 +1,124 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  Copyright (C) 2020 Werner Schweer and others
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2
+//  as published by the Free Software Foundation and appearing in
+//  the file LICENCE.GPL
+//=============================================================================
+
+#ifndef __IMPORTMXMLREADER_H__
+#define __IMPORTMXMLREADER_H__
+
+namespace Ms {
+
+class MxmlAttributes;
+
+//---------------------------------------------------------
+//   MxmlTokens
+//    the token stream of a MusicXML document, read once
+//    and replayed by an MxmlReader for each import pass
+//---------------------------------------------------------
+
+class MxmlTokens {
+      friend class MxmlReader;
+      friend class MxmlAttributes;
+
+      struct Token {
+            QXmlStreamReader::TokenType type;
+            int name;               ///< id of the element name, -1 if none
+            int offset;             ///< characters: into _text, start element: first attribute
+            int length;             ///< characters: length, start element: number of attributes
+            int line;
+            int column;
+            };
+
+      struct Attribute {
+            int name;               ///< id of the attribute name
+            int offset;             ///< value, into _text
+            int length;
+            };
+
+      QString _text;                            ///< the document, followed by the text that is not in it verbatim
+      QVector<Token> _tokens;
+      QVector<Attribute> _attributes;
+      QVector<QString> _names;                  ///< element and attribute names, each stored once
+      QString _errorString;                     ///< set if the document is not well-formed
+
+   public:
+      void read(QIODevice* device);
+      int size() const { return _tokens.size(); }
+      bool hasError() const { return !_errorString.isEmpty(); }
+      const QString& errorString() const { return _errorString; }
+      };
+
+//---------------------------------------------------------
+//   MxmlAttributes
+//    the attributes of a start element, with the subset
+//    of the QXmlStreamAttributes interface used by the
+//    import passes
+//---------------------------------------------------------
+
+class MxmlAttributes {
+      const MxmlTokens* _tokens = nullptr;
+      int _first = 0;
+      int _size = 0;
+
+      const MxmlTokens::Attribute& at(int i) const { return _tokens->_attributes[_first + i]; }
+      int indexOf(const char* name) const;
+
+   public:
+      MxmlAttributes() {}
+      MxmlAttributes(const MxmlTokens* tokens, int first, int size) : _tokens(tokens), _first(first), _size(size) {}
+
+      int size() const { return _size; }
+      bool isEmpty() const { return _size == 0; }
+      QStringRef name(int i) const { return QStringRef(&_tokens->_names[at(i).name]); }
+      QStringRef value(int i) const { return QStringRef(&_tokens->_text, at(i).offset, at(i).length); }
+
+      QStringRef value(const char* name) const;
+      bool hasAttribute(const char* name) const { return indexOf(name) >= 0; }
+      };
+
+//---------------------------------------------------------
+//   MxmlReader
+//    replays MxmlTokens with the subset of the
+//    QXmlStreamReader interface used by the import passes
+//---------------------------------------------------------
+
+class MxmlReader {
+      const MxmlTokens* _tokens = nullptr;
+      int _pos = -1;
+      bool _error = false;
+
+      const MxmlTokens::Token& token() const { return _tokens->_tokens[_pos]; }
+      bool valid() const { return _tokens && _pos >= 0 && _pos < _tokens->_tokens.size(); }
+
+   public:
+      void setTokens(const MxmlTokens* tokens);
+
+      QXmlStreamReader::TokenType readNext();
+      bool readNextStartElement();
+      void skipCurrentElement();
+      QString readElementText();
+
+      QXmlStreamReader::TokenType tokenType() const { return valid() ? token().type : QXmlStreamReader::Invalid; }
+      QString tokenString() const;
+      bool isStartElement() const { return tokenType() == QXmlStreamReader::StartElement; }
+      bool isEndElement() const   { return tokenType() == QXmlStreamReader::EndElement; }
+      bool atEnd() const          { return _error || !_tokens || _pos >= _tokens->_tokens.size(); }
+      bool hasError() const       { return _error; }
+
+      QStringRef name() const;
+      QStringRef text() const;
+      MxmlAttributes attributes() const;
+      qint64 lineNumber() const   { return valid() ? token().line : 0; }
+      qint64 columnNumber() const { return valid() ? token().column : 0; }
+      };
+
+} // namespace Ms
+
+#endif
@@ -128,12 +128,13 @@ static int musicXMLValidationErrorDialog(QString text, QString detailedText)
 //---------------------------------------------------------
 
 /**
-Extract rootfile from compressed MusicXML file \a qf, return true if OK and false on error.
+Extract rootfile from compressed MusicXML file \a name read from device \a dev,
+return true if OK and false on error.
 */
 
-static bool extractRootfile(QFile* qf, QByteArray& data)
+static bool extractRootfile(QIODevice* dev, const QString& name, QByteArray& data)
       {
-      MQZipReader f(qf->fileName());
+      MQZipReader f(dev);
       data = f.fileData("META-INF/container.xml");
 
       QDomDocument container;
@@ -168,8 +169,8 @@ static bool extractRootfile(QFile* qf, QByteArray& data)
             }
 
       if (rootfile == "") {
-            qDebug("can't find rootfile in: %s", qPrintable(qf->fileName()));
-            MScore::lastError = QObject::tr("Can't find rootfile\n%1").arg(qf->fileName());
+            qDebug("can't find rootfile in: %s", qPrintable(name));
+            MScore::lastError = QObject::tr("Can't find rootfile\n%1").arg(name);
             return false;
             }
 
@@ -307,7 +308,16 @@ Score::FileError importCompressedMusicXml(MasterScore* score, const QString& nam
       QFile mxlFile(name);
       if (!mxlFile.exists())
             return Score::FileError::FILE_NOT_FOUND;
-      if (!mxlFile.open(QIODevice::ReadOnly)) {
+      return importCompressedMusicXml(score, &mxlFile, name);
+      }
+
+/**
+ Import compressed MusicXML from the unopened device \a dev into the Score.
+ */
+
+Score::FileError importCompressedMusicXml(MasterScore* score, QIODevice* dev, const QString& name)
+      {
+      if (!dev->open(QIODevice::ReadOnly)) {
             qDebug("importCompressedMusicXml() could not open compressed MusicXML file '%s'", qPrintable(name));
             MScore::lastError = QObject::tr("Could not open compressed MusicXML file\n%1").arg(name);
             return Score::FileError::FILE_OPEN_ERROR;
@@ -315,7 +325,7 @@ Score::FileError importCompressedMusicXml(MasterScore* score, const QString& nam
 
       // extract the root file
       QByteArray data;
-      if (!extractRootfile(&mxlFile, data))
+      if (!extractRootfile(dev, name, data))
             return Score::FileError::FILE_BAD_FORMAT;  // appropriate error message has been printed by extractRootfile
       QBuffer buffer(&data);
       buffer.open(QIODevice::ReadOnly);
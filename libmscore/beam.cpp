@@ -2083,58 +2083,66 @@ void Beam::read(XmlReader& e)
       if (score()->mscVersion() < 301)
             _id = e.intAttribute("id");
       while (e.readNextStartElement()) {
-            const QStringRef& tag(e.name());
-            if (tag == "StemDirection") {
-                  readProperty(e, Pid::STEM_DIRECTION);
-                  e.readNext();
-                  }
-            else if (tag == "distribute")
-                  setDistribute(e.readInt());
-            else if (readStyledProperty(e, tag))
-                  ;
-            else if (tag == "growLeft")
-                  setGrowLeft(e.readDouble());
-            else if (tag == "growRight")
-                  setGrowRight(e.readDouble());
-            else if (tag == "y1") {
-                  if (fragments.empty())
-                        fragments.append(new BeamFragment);
-                  BeamFragment* f = fragments.back();
-                  int idx = (_direction == Direction::AUTO || _direction == Direction::DOWN) ? 0 : 1;
-                  _userModified[idx] = true;
-                  f->py1[idx] = e.readDouble() * _spatium;
-                  }
-            else if (tag == "y2") {
-                  if (fragments.empty())
-                        fragments.append(new BeamFragment);
-                  BeamFragment* f = fragments.back();
-                  int idx = (_direction == Direction::AUTO || _direction == Direction::DOWN) ? 0 : 1;
-                  _userModified[idx] = true;
-                  f->py2[idx] = e.readDouble() * _spatium;
-                  }
-            else if (tag == "Fragment") {
-                  BeamFragment* f = new BeamFragment;
-                  int idx = (_direction == Direction::AUTO || _direction == Direction::DOWN) ? 0 : 1;
-                  _userModified[idx] = true;
-                  qreal _spatium1 = spatium();
-
-                  while (e.readNextStartElement()) {
-                        const QStringRef& tag1(e.name());
-                        if (tag1 == "y1")
-                              f->py1[idx] = e.readDouble() * _spatium1;
-                        else if (tag1 == "y2")
-                              f->py2[idx] = e.readDouble() * _spatium1;
-                        else
-                              e.unknown();
+            switch (e.tag()) {
+                  case XmlTag::STEM_DIRECTION:
+                        readProperty(e, Pid::STEM_DIRECTION);
+                        e.readNext();
+                        break;
+                  case XmlTag::DISTRIBUTE:
+                        setDistribute(e.readInt());
+                        break;
+                  case XmlTag::GROW_LEFT:
+                        setGrowLeft(e.readDouble());
+                        break;
+                  case XmlTag::GROW_RIGHT:
+                        setGrowRight(e.readDouble());
+                        break;
+                  case XmlTag::Y1: {
+                        if (fragments.empty())
+                              fragments.append(new BeamFragment);
+                        BeamFragment* f = fragments.back();
+                        int idx = (_direction == Direction::AUTO || _direction == Direction::DOWN) ? 0 : 1;
+                        _userModified[idx] = true;
+                        f->py1[idx] = e.readDouble() * _spatium;
+                        }
+                        break;
+                  case XmlTag::Y2: {
+                        if (fragments.empty())
+                              fragments.append(new BeamFragment);
+                        BeamFragment* f = fragments.back();
+                        int idx = (_direction == Direction::AUTO || _direction == Direction::DOWN) ? 0 : 1;
+                        _userModified[idx] = true;
+                        f->py2[idx] = e.readDouble() * _spatium;
+                        }
+                        break;
+                  case XmlTag::FRAGMENT: {
+                        BeamFragment* f = new BeamFragment;
+                        int idx = (_direction == Direction::AUTO || _direction == Direction::DOWN) ? 0 : 1;
+                        _userModified[idx] = true;
+                        qreal _spatium1 = spatium();
+
+                        while (e.readNextStartElement()) {
+                              const XmlTag tag1 = e.tag();
+                              if (tag1 == XmlTag::Y1)
+                                    f->py1[idx] = e.readDouble() * _spatium1;
+                              else if (tag1 == XmlTag::Y2)
+                                    f->py2[idx] = e.readDouble() * _spatium1;
+                              else
+                                    e.unknown();
+                              }
+                        fragments.append(f);
                         }
-                  fragments.append(f);
+                        break;
+                  case XmlTag::L1:              // ignore
+                  case XmlTag::L2:
+                  case XmlTag::SUBTYPE:         // obsolete
+                        e.skipCurrentElement();
+                        break;
+                  default:
+                        if (!readStyledProperty(e, e.name()) && !Element::readProperties(e))
+                              e.unknown();
+                        break;
                   }
-            else if (tag == "l1" || tag == "l2")      // ignore
-                  e.skipCurrentElement();
-            else if (tag == "subtype")          // obsolete
-                  e.skipCurrentElement();
-            else if (!Element::readProperties(e))
-                  e.unknown();
             }
       }
 
@@ -208,108 +208,118 @@ void ChordRest::writeProperties(XmlWriter& xml) const
 
 bool ChordRest::readProperties(XmlReader& e)
       {
-      const QStringRef& tag(e.name());
-
-      if (tag == "durationType") {
-            setDurationType(e.readElementText());
-            if (actualDurationType().type() != TDuration::DurationType::V_MEASURE) {
-                  if (score()->mscVersion() < 112 && (type() == ElementType::REST) &&
-                              // for backward compatibility, convert V_WHOLE rests to V_MEASURE
-                              // if long enough to fill a measure.
-                              // OTOH, freshly created (un-initialized) rests have numerator == 0 (< 4/4)
-                              // (see Fraction() constructor in fraction.h; this happens for instance
-                              // when pasting selection from clipboard): they should not be converted
-                              ticks().numerator() != 0 &&
-                              // rest durations are initialized to full measure duration when
-                              // created upon reading the <Rest> tag (see Measure::read() )
-                              // so a V_WHOLE rest in a measure of 4/4 or less => V_MEASURE
-                              (actualDurationType()==TDuration::DurationType::V_WHOLE && ticks() <= Fraction(4, 4)) ) {
-                        // old pre 2.0 scores: convert
-                        setDurationType(TDuration::DurationType::V_MEASURE);
+      switch (e.tag()) {
+            case XmlTag::DURATION_TYPE:
+                  setDurationType(e.readElementText());
+                  if (actualDurationType().type() != TDuration::DurationType::V_MEASURE) {
+                        if (score()->mscVersion() < 112 && (type() == ElementType::REST) &&
+                                    // for backward compatibility, convert V_WHOLE rests to V_MEASURE
+                                    // if long enough to fill a measure.
+                                    // OTOH, freshly created (un-initialized) rests have numerator == 0 (< 4/4)
+                                    // (see Fraction() constructor in fraction.h; this happens for instance
+                                    // when pasting selection from clipboard): they should not be converted
+                                    ticks().numerator() != 0 &&
+                                    // rest durations are initialized to full measure duration when
+                                    // created upon reading the <Rest> tag (see Measure::read() )
+                                    // so a V_WHOLE rest in a measure of 4/4 or less => V_MEASURE
+                                    (actualDurationType()==TDuration::DurationType::V_WHOLE && ticks() <= Fraction(4, 4)) ) {
+                              // old pre 2.0 scores: convert
+                              setDurationType(TDuration::DurationType::V_MEASURE);
+                              }
+                        else  // not from old score: set duration fraction from duration type
+                              setTicks(actualDurationType().fraction());
+                        }
+                  else {
+                        if (score()->mscVersion() <= 114) {
+                              SigEvent event = score()->sigmap()->timesig(e.tick());
+                              setTicks(event.timesig());
+                              }
                         }
-                  else  // not from old score: set duration fraction from duration type
-                        setTicks(actualDurationType().fraction());
+                  break;
+            case XmlTag::BEAM_MODE: {
+                  QString val(e.readElementText());
+                  Beam::Mode bm = Beam::Mode::AUTO;
+                  if (val == "auto")
+                        bm = Beam::Mode::AUTO;
+                  else if (val == "begin")
+                        bm = Beam::Mode::BEGIN;
+                  else if (val == "mid")
+                        bm = Beam::Mode::MID;
+                  else if (val == "end")
+                        bm = Beam::Mode::END;
+                  else if (val == "no")
+                        bm = Beam::Mode::NONE;
+                  else if (val == "begin32")
+                        bm = Beam::Mode::BEGIN32;
+                  else if (val == "begin64")
+                        bm = Beam::Mode::BEGIN64;
+                  else
+                        bm = Beam::Mode(val.toInt());
+                  _beamMode = Beam::Mode(bm);
                   }
-            else {
-                  if (score()->mscVersion() <= 114) {
-                        SigEvent event = score()->sigmap()->timesig(e.tick());
-                        setTicks(event.timesig());
+                  break;
+            case XmlTag::ARTICULATION: {
+                  Articulation* atr = new Articulation(score());
+                  atr->setTrack(track());
+                  atr->read(e);
+                  add(atr);
+                  }
+                  break;
+            case XmlTag::LEADING_SPACE:
+            case XmlTag::TRAILING_SPACE:
+                  qDebug("ChordRest: %s obsolete", e.name().toLocal8Bit().data());
+                  e.skipCurrentElement();
+                  break;
+            case XmlTag::SMALL:
+                  _small = e.readInt();
+                  break;
+            case XmlTag::DURATION:
+                  setTicks(e.readFraction());
+                  break;
+            case XmlTag::TICKLEN: {       // obsolete (version < 1.12)
+                  int mticks = score()->sigmap()->timesig(e.tick()).timesig().ticks();
+                  int i = e.readInt();
+                  if (i == 0)
+                        i = mticks;
+                  if ((type() == ElementType::REST) && (mticks == i)) {
+                        setDurationType(TDuration::DurationType::V_MEASURE);
+                        setTicks(Fraction::fromTicks(i));
+                        }
+                  else {
+                        Fraction f = Fraction::fromTicks(i);
+                        setTicks(f);
+                        setDurationType(TDuration(f));
                         }
                   }
-            }
-      else if (tag == "BeamMode") {
-            QString val(e.readElementText());
-            Beam::Mode bm = Beam::Mode::AUTO;
-            if (val == "auto")
-                  bm = Beam::Mode::AUTO;
-            else if (val == "begin")
-                  bm = Beam::Mode::BEGIN;
-            else if (val == "mid")
-                  bm = Beam::Mode::MID;
-            else if (val == "end")
-                  bm = Beam::Mode::END;
-            else if (val == "no")
-                  bm = Beam::Mode::NONE;
-            else if (val == "begin32")
-                  bm = Beam::Mode::BEGIN32;
-            else if (val == "begin64")
-                  bm = Beam::Mode::BEGIN64;
-            else
-                  bm = Beam::Mode(val.toInt());
-            _beamMode = Beam::Mode(bm);
-            }
-      else if (tag == "Articulation") {
-            Articulation* atr = new Articulation(score());
-            atr->setTrack(track());
-            atr->read(e);
-            add(atr);
-            }
-      else if (tag == "leadingSpace" || tag == "trailingSpace") {
-            qDebug("ChordRest: %s obsolete", tag.toLocal8Bit().data());
-            e.skipCurrentElement();
-            }
-      else if (tag == "small")
-            _small = e.readInt();
-      else if (tag == "duration")
-            setTicks(e.readFraction());
-      else if (tag == "ticklen") {      // obsolete (version < 1.12)
-            int mticks = score()->sigmap()->timesig(e.tick()).timesig().ticks();
-            int i = e.readInt();
-            if (i == 0)
-                  i = mticks;
-            if ((type() == ElementType::REST) && (mticks == i)) {
-                  setDurationType(TDuration::DurationType::V_MEASURE);
-                  setTicks(Fraction::fromTicks(i));
+                  break;
+            case XmlTag::DOTS:
+                  setDots(e.readInt());
+                  break;
+            case XmlTag::STAFF_MOVE:
+                  _staffMove = e.readInt();
+                  if (vStaffIdx() < part()->staves()->first()->idx() || vStaffIdx() > part()->staves()->last()->idx())
+                        _staffMove = 0;
+                  break;
+            case XmlTag::SPANNER:
+                  Spanner::readSpanner(e, this, track());
+                  break;
+            case XmlTag::LYRICS: {
+                  Element* element = new Lyrics(score());
+                  element->setTrack(e.track());
+                  element->read(e);
+                  add(element);
                   }
-            else {
-                  Fraction f = Fraction::fromTicks(i);
-                  setTicks(f);
-                  setDurationType(TDuration(f));
+                  break;
+            case XmlTag::POS: {
+                  QPointF pt = e.readPoint();
+                  setOffset(pt * spatium());
                   }
+                  break;
+//            case XmlTag::OFFSET:
+//                  DurationElement::readProperties(e);
+            default:
+                  return DurationElement::readProperties(e);
             }
-      else if (tag == "dots")
-            setDots(e.readInt());
-      else if (tag == "staffMove") {
-            _staffMove = e.readInt();
-            if (vStaffIdx() < part()->staves()->first()->idx() || vStaffIdx() > part()->staves()->last()->idx())
-                  _staffMove = 0;
-            }
-      else if (tag == "Spanner")
-            Spanner::readSpanner(e, this, track());
-      else if (tag == "Lyrics") {
-            Element* element = new Lyrics(score());
-            element->setTrack(e.track());
-            element->read(e);
-            add(element);
-            }
-      else if (tag == "pos") {
-            QPointF pt = e.readPoint();
-            setOffset(pt * spatium());
-            }
-//      else if (tag == "offset")
-//            DurationElement::readProperties(e);
-      else if (!DurationElement::readProperties(e))
-            return false;
       return true;
       }
 
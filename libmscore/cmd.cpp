@@ -198,6 +198,20 @@ void CmdState::setUpdateMode(UpdateMode m)
             _setUpdateMode(m);
       }
 
+//---------------------------------------------------------
+//   completePendingLayouts
+//    a layout started by doLayoutPages() is completed
+//    before a command changes the scores it lays out
+//---------------------------------------------------------
+
+static void completePendingLayouts(Score* score)
+      {
+      for (MasterScore* ms : *score->movements()) {
+            for (Score* s : ms->scoreList())
+                  s->continueLayout();
+            }
+      }
+
 //---------------------------------------------------------
 //   startCmd
 ///   Start a GUI command by clearing the redraw area
@@ -209,6 +223,7 @@ void Score::startCmd()
       if (MScore::debugMode)
             qDebug("===startCmd()");
 
+      completePendingLayouts(this);
       cmdState().reset();
 
       // Start collecting low-level undo operations for a
@@ -228,6 +243,7 @@ void Score::undoRedo(bool undo, EditData* ed)
       {
       if (readOnly())
             return;
+      completePendingLayouts(this);
       cmdState().reset();
       if (undo)
             undoStack()->undo(ed);
@@ -298,8 +314,12 @@ void Score::update(bool resetCmdState)
             CmdState& cs = ms->cmdState();
             ms->deletePostponed();
             if (cs.layoutRange()) {
-                  for (Score* s : ms->scoreList())
-                        s->doLayoutRange(cs.startTick(), cs.endTick());
+                  for (Score* s : ms->scoreList()) {
+                        if (MScore::deferExcerpts && !s->isMaster())
+                              s->invalidateLayout();        // laid out when the part is used
+                        else
+                              s->doLayoutRange(cs.startTick(), cs.endTick());
+                        }
                   updateAll = true;
                   }
             }
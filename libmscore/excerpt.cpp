@@ -12,6 +12,7 @@
 
 #include "excerpt.h"
 #include "score.h"
+#include "mscore.h"
 #include "part.h"
 #include "xml.h"
 #include "staff.h"
@@ -229,11 +230,14 @@ void Excerpt::createExcerpt(Excerpt* excerpt)
             }
 
       // initial layout of score
+      // with MScore::deferExcerpts it is only needed for the mmrests of transposed harmonies
+      const bool transpose = oscore->styleB(Sid::concertPitch) != score->styleB(Sid::concertPitch);
       score->addLayoutFlags(LayoutFlag::FIX_PITCH_VELO);
-      score->doLayout();
+      if (transpose || !MScore::deferExcerpts)
+            score->doLayout();
 
       // handle transposing instruments
-      if (oscore->styleB(Sid::concertPitch) != score->styleB(Sid::concertPitch)) {
+      if (transpose) {
             for (const Staff* staff : score->staves()) {
                   if (staff->staffType(Fraction(0,1))->group() == StaffGroup::PERCUSSION)
                         continue;
@@ -297,7 +301,10 @@ void Excerpt::createExcerpt(Excerpt* excerpt)
       oscore->updateChannel();
 
       score->setLayoutAll();
-      score->doLayout();
+      if (MScore::deferExcerpts)
+            score->invalidateLayout();    // laid out when the part is used
+      else
+            score->doLayout();
       }
 
 //---------------------------------------------------------
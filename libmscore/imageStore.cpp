@@ -68,6 +68,7 @@ bool ImageStoreItem::isUsed(Score* score) const
 
 void ImageStoreItem::load()
       {
+      unpack();
       if (!_buffer.isEmpty())
             return;
       QFile inFile(_path);
@@ -82,6 +83,20 @@ void ImageStoreItem::load()
       _hash = h.result();
       }
 
+//---------------------------------------------------------
+//   unpack
+//    produce the buffer of an item added with
+//    ImageStore::addDeferred()
+//---------------------------------------------------------
+
+void ImageStoreItem::unpack() const
+      {
+      if (!_unpack)
+            return;
+      _buffer = _unpack();
+      _unpack = nullptr;
+      }
+
 //---------------------------------------------------------
 //   hashName
 //---------------------------------------------------------
@@ -154,8 +169,8 @@ ImageStore::~ImageStore()
 
 ImageStoreItem* ImageStore::getImage(const QString& path) const
       {
-      QString s = QFileInfo(path).completeBaseName();
-      if (s.size() != 32) {
+      QByteArray hash = hashFromName(path);
+      if (hash.isEmpty()) {
             //
             // some limited support for backward compatibility
             //
@@ -164,16 +179,12 @@ ImageStoreItem* ImageStore::getImage(const QString& path) const
                         return item;
                   }
             qDebug("ImageStore::getImage(%s): bad base name <%s>",
-               qPrintable(path), qPrintable(s));
+               qPrintable(path), qPrintable(QFileInfo(path).completeBaseName()));
             for (ImageStoreItem* item : _items)
                   qDebug("    in store: <%s>", qPrintable(item->path()));
 
             return 0;
             }
-      QByteArray hash(16, 0);
-      for (int i = 0; i < 16; ++i) {
-            hash[i] = toInt(s[i * 2].toLatin1()) * 16 + toInt(s[i * 2 + 1].toLatin1());
-            }
       for (ImageStoreItem* item : _items) {
             if (item->hash() == hash)
                   return item;
@@ -182,6 +193,25 @@ ImageStoreItem* ImageStore::getImage(const QString& path) const
       return 0;
       }
 
+//---------------------------------------------------------
+//   hashFromName
+//    images are stored under the hex encoded md4 hash of
+//    their contents, return that hash or an empty array
+//    if path is not named that way
+//---------------------------------------------------------
+
+QByteArray ImageStore::hashFromName(const QString& path)
+      {
+      QString s = QFileInfo(path).completeBaseName();
+      if (s.size() != 32)
+            return QByteArray();
+      QByteArray hash(16, 0);
+      for (int i = 0; i < 16; ++i) {
+            hash[i] = toInt(s[i * 2].toLatin1()) * 16 + toInt(s[i * 2 + 1].toLatin1());
+            }
+      return hash;
+      }
+
 //---------------------------------------------------------
 //   add
 //---------------------------------------------------------
@@ -201,6 +231,28 @@ ImageStoreItem* ImageStore::add(const QString& path, const QByteArray& ba)
       return item;
       }
 
+//---------------------------------------------------------
+//   addDeferred
+//    add an image whose data is produced by unpack when it
+//    is first needed; the hash is taken from the name, so
+//    unnamed images are unpacked right away
+//---------------------------------------------------------
+
+ImageStoreItem* ImageStore::addDeferred(const QString& path, std::function<QByteArray()> unpack)
+      {
+      QByteArray hash = hashFromName(path);
+      if (hash.isEmpty())
+            return add(path, unpack());
+      for (ImageStoreItem* item : _items) {
+            if (item->hash() == hash)
+                  return item;
+            }
+      ImageStoreItem* item = new ImageStoreItem(path);
+      item->setDeferred(hash, unpack);
+      _items.push_back(item);
+      return item;
+      }
+
 //---------------------------------------------------------
 //   clearUnused
 //---------------------------------------------------------
@@ -26,8 +26,11 @@ class ImageStoreItem {
       QList<Image*> _references;
       QString _path;                // original location of image
       QString _type;                // image type (file extension)
-      QByteArray _buffer;
+      mutable QByteArray _buffer;
       QByteArray _hash;             // 16 byte md4 hash of _buffer
+      mutable std::function<QByteArray()> _unpack;    // produces _buffer on first use
+
+      void unpack() const;
 
    public:
       ImageStoreItem(const QString& p);
@@ -35,16 +38,17 @@ class ImageStoreItem {
       void reference(Image*);
 
       const QString& path() const      { return _path;     }
-      QByteArray& buffer()             { return _buffer;   }
-      const QByteArray& buffer() const { return _buffer;   }
-      bool loaded() const              { return !_buffer.isEmpty();   }
+      QByteArray& buffer()             { unpack(); return _buffer;   }
+      const QByteArray& buffer() const { unpack(); return _buffer;   }
+      bool loaded() const              { return !_buffer.isEmpty() || _unpack;   }
       void setPath(const QString& val);
       bool isUsed(Score*) const;
       bool isUsed() const { return !_references.empty(); }
       void load();
       QString hashName() const;
       const QByteArray& hash() const   { return _hash; }
-      void set(const QByteArray& b, const QByteArray& h) { _buffer = b; _hash = h; }
+      void set(const QByteArray& b, const QByteArray& h) { _buffer = b; _hash = h; _unpack = nullptr; }
+      void setDeferred(const QByteArray& h, std::function<QByteArray()> f) { _buffer.clear(); _hash = h; _unpack = f; }
       };
 
 //---------------------------------------------------------
@@ -63,6 +67,8 @@ class ImageStore {
 
       ImageStoreItem* getImage(const QString& path) const;
       ImageStoreItem* add(const QString& path, const QByteArray&);
+      ImageStoreItem* addDeferred(const QString& path, std::function<QByteArray()> unpack);
+      static QByteArray hashFromName(const QString& path);
       void clearUnused();
 
       typedef ItemList::iterator iterator;
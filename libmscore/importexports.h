@@ -30,6 +30,7 @@ namespace Ms {
     QJsonObject savePositions(Score* score, bool segments);
 
     QJsonObject saveMetadataJSON(Score* score);
+    bool scanMetadataJSON(const QByteArray& data, const QString& name, QJsonObject* json, QStringList* missing);
 
     // imports
     // mscore/musescore.h#L973-L982, mscore/file.cpp#L2320 readScore
@@ -38,6 +39,12 @@ namespace Ms {
     extern Score::FileError importBww(MasterScore*, const QString& path);
     extern Score::FileError importMusicXml(MasterScore*, const QString&);
     extern Score::FileError importCompressedMusicXml(MasterScore*, const QString&);
+
+    // imports from memory, `name` only selects the file type and names the score
+    extern Score::FileError importMidi(MasterScore*, const QByteArray& data, const QString& name);
+    extern Score::FileError importGTP(MasterScore*, QIODevice*, const QString& name);
+    extern Score::FileError importMusicXml(MasterScore*, QIODevice*, const QString& name);
+    extern Score::FileError importCompressedMusicXml(MasterScore*, QIODevice*, const QString& name);
     extern Score::FileError importMuseData(MasterScore*, const QString& name);
     extern Score::FileError importLilypond(MasterScore*, const QString& name);
     extern Score::FileError importBB(MasterScore*, const QString& name);
@@ -24,6 +24,7 @@
 #include "keysig.h"
 #include "layoutbreak.h"
 #include "layout.h"
+#include "layoutprofile.h"
 #include "lyrics.h"
 #include "marker.h"
 #include "measure.h"
@@ -145,6 +146,7 @@ static bool vUp(Chord* chord)
 
 void Score::layoutChords1(Segment* segment, int staffIdx)
       {
+      LayoutTimer timer(this, LayoutProfile::Phase::LAYOUT_CHORDS1);
       const Staff* staff = Score::staff(staffIdx);
       const int startTrack = staffIdx * VOICES;
       const int endTrack   = startTrack + VOICES;
@@ -845,6 +847,7 @@ static QPair<qreal, qreal> layoutAccidental(AcEl* me, AcEl* above, AcEl* below,
 
 void Score::layoutChords3(std::vector<Note*>& notes, const Staff* staff, Segment* segment)
       {
+      LayoutTimer timer(this, LayoutProfile::Phase::LAYOUT_CHORDS3);
       //---------------------------------------------------
       //    layout accidentals
       //    find column for dots
@@ -1323,6 +1326,7 @@ void Score::layoutSpanner()
 
 void Score::hideEmptyStaves(System* system, bool isFirstSystem)
       {
+      LayoutTimer timer(this, LayoutProfile::Phase::HIDE_EMPTY_STAVES);
       int staves   = _staves.size();
       int staffIdx = 0;
       bool systemIsEmpty = true;
@@ -1566,6 +1570,7 @@ bool inline almostZero(qreal value)
 
 static void distributeStaves(Page* page)
       {
+      LayoutTimer timer(page->score(), LayoutProfile::Phase::DISTRIBUTE_STAVES);
       Score* score { page->score() };
       VerticalGapDataList vgdl;
 
@@ -1757,6 +1762,7 @@ static void distributeStaves(Page* page)
 
 static void layoutPage(Page* page, qreal restHeight)
       {
+      LayoutTimer timer(page->score(), LayoutProfile::Phase::LAYOUT_PAGE);
       if (restHeight < 0.0) {
             qDebug("restHeight < 0.0: %f\n", restHeight);
             restHeight = 0;
@@ -2353,6 +2359,8 @@ void Score::createMMRest(Measure* m, Measure* lm, const Fraction& len)
                   }
             }
       MeasureBase* nm = _showVBox ? lm->next() : lm->nextMeasure();
+      if (mmr->next() != nm || mmr->prev() != m->prev())
+            _measures.changed();
       mmr->setNext(nm);
       mmr->setPrev(m->prev());
       }
@@ -2518,6 +2526,7 @@ int LayoutContext::adjustMeasureNo(MeasureBase* m)
 
 void Score::createBeams(LayoutContext& lc, Measure* measure)
       {
+      LayoutTimer timer(this, LayoutProfile::Phase::CREATE_BEAMS);
       bool crossMeasure = styleB(Sid::crossMeasureValues);
 
       for (int track = 0; track < ntracks(); ++track) {
@@ -2864,6 +2873,8 @@ void Score::getNextMeasure(LayoutContext& lc)
             lc.nextMeasure = _showVBox ? lc.curMeasure->next() : lc.curMeasure->nextMeasure();
       if (!lc.curMeasure)
             return;
+      LayoutTimer timer(this, LayoutProfile::Phase::GET_NEXT_MEASURE);
+      timer.setMeasure(lc.curMeasure);
 
       int mno = lc.adjustMeasureNo(lc.curMeasure);
 
@@ -3380,6 +3391,7 @@ static void restoreBeams(Measure* m)
 
 void Score::layoutLyrics(System* system)
       {
+      LayoutTimer timer(this, LayoutProfile::Phase::LAYOUT_LYRICS);
       std::vector<int> visibleStaves;
       for (int staffIdx = system->firstVisibleStaff(); staffIdx < nstaves(); staffIdx = system->nextVisibleStaff(staffIdx))
             visibleStaves.push_back(staffIdx);
@@ -3703,6 +3715,7 @@ void alignHarmonies(const System* system, const std::vector<Segment*>& sl, bool
 
 static void processLines(System* system, std::vector<Spanner*> lines, bool align)
       {
+      LayoutTimer timer(system->score(), LayoutProfile::Phase::SPANNERS);
       std::vector<SpannerSegment*> segments;
       for (Spanner* sp : lines) {
             SpannerSegment* ss = sp->layoutSystem(system);     // create/layout spanner segment for this system
@@ -3750,6 +3763,8 @@ System* Score::collectSystem(LayoutContext& lc)
       {
       if (!lc.curMeasure)
             return 0;
+      LayoutTimer timer(this, LayoutProfile::Phase::COLLECT_SYSTEM);
+      timer.setMeasure(lc.curMeasure);
       const MeasureBase* measure  = _systems.empty() ? 0 : _systems.back()->measures().back();
       if (measure)
             measure = measure->findPotentialSectionBreak();
@@ -4084,6 +4099,7 @@ System* Score::collectSystem(LayoutContext& lc)
 
 void Score::layoutSystemElements(System* system, LayoutContext& lc)
       {
+      LayoutTimer timer(this, LayoutProfile::Phase::LAYOUT_SYSTEM_ELEMENTS);
       //-------------------------------------------------------------
       //    create cr segment list to speed up computations
       //-------------------------------------------------------------
@@ -4453,11 +4469,14 @@ void Score::layoutSystemElements(System* system, LayoutContext& lc)
       layoutLyrics(system);
 
       // here are lyrics dashes and melisma
+      {
+      LayoutTimer timer(this, LayoutProfile::Phase::SPANNERS);
       for (Spanner* sp : _unmanagedSpanner) {
             if (sp->tick() >= etick || sp->tick2() <= stick)
                   continue;
             sp->layoutSystem(system);
             }
+      }
 
       //
       // We need to known if we have FretDiagrams in the system to decide when to layout the Harmonies
@@ -4619,6 +4638,7 @@ void Score::layoutSystemElements(System* system, LayoutContext& lc)
 
 void LayoutContext::collectPage()
       {
+      LayoutTimer timer(score, LayoutProfile::Phase::COLLECT_PAGE);
       const qreal slb = score->styleP(Sid::staffLowerBorder);
       bool breakPages = score->layoutMode() != LayoutMode::SYSTEM;
       qreal ey        = page->height() - page->bm();
@@ -4876,9 +4896,106 @@ class CmdStateLocker {
 
 void Score::doLayoutRange(const Fraction& st, const Fraction& et)
       {
+      Fraction stick(st);
+      Fraction etick(et);
+      if (_pendingLayout) {
+            // commands complete a pending layout before they change the score (see startCmd()),
+            // so this is a change outside of a command: the rest of the layout may refer to
+            // removed elements, drop it and lay out the whole score
+            discardPendingLayout();
+            stick = Fraction(0,1);
+            etick = Fraction(-1,1);
+            }
       CmdStateLocker cmdStateLocker(this);
+      LayoutTimer timer(this, LayoutProfile::Phase::LAYOUT);
       LayoutContext lc(this);
+      if (startLayoutRange(lc, stick, etick))
+            lc.layout();
+      if (stick <= Fraction(0,1) && etick < Fraction(0,1))
+            _layoutValid = true;
+      else
+            _layoutValid = _layoutValid && _validLayoutMode == _layoutMode;
+      _validLayoutMode = _layoutMode;
+      }
+
+//---------------------------------------------------------
+//   doLayoutPages
+//    start a complete layout and stop it once n pages
+//    are laid out, continueLayout() lays out the rest
+//---------------------------------------------------------
+
+void Score::doLayoutPages(int n)
+      {
+      continueLayout();
+      LayoutTimer timer(this, LayoutProfile::Phase::LAYOUT);
+      LayoutContext* lc = new LayoutContext(this);
+      cmdState().lock();
+      const bool started = startLayoutRange(*lc, Fraction(0,1), Fraction(-1,1));
+      cmdState().unlock();
+      _layoutValid     = true;      // the rest is laid out in the same mode, see setLayoutMode()
+      _validLayoutMode = _layoutMode;
+      if (!started) {         // empty score or line mode, laid out completely
+            delete lc;
+            return;
+            }
+      _pendingLayout = lc;
+      continueLayout(n);
+      }
+
+//---------------------------------------------------------
+//   continueLayout
+//    continue the layout started by doLayoutPages() until
+//    n pages are laid out, n < 0 completes it
+//---------------------------------------------------------
+
+void Score::continueLayout(int n)
+      {
+      if (!_pendingLayout)
+            return;
+      CmdStateLocker cmdStateLocker(this);
+      LayoutTimer timer(this, LayoutProfile::Phase::LAYOUT);
+      LayoutContext* lc = _pendingLayout;
+      while (n < 0 || lc->curPage < n) {
+            if (!lc->layoutNextPage()) {
+                  lc->layoutDone();
+                  _pendingLayout = 0;
+                  delete lc;
+                  return;
+                  }
+            }
+      }
+
+//---------------------------------------------------------
+//   discardPendingLayout
+//    drop the rest of a layout started by doLayoutPages()
+//    without using it, the score needs a complete layout
+//    afterwards
+//---------------------------------------------------------
+
+void Score::discardPendingLayout()
+      {
+      if (!_pendingLayout)
+            return;
+      LayoutContext* lc = _pendingLayout;
+      _pendingLayout = 0;
+      // the systems not reused yet are deleted by the next complete layout
+      _systems.append(lc->systemList);
+      lc->systemList.clear();
+      // the spanners may be gone already
+      lc->processedSpanners.clear();
+      lc->score = this;
+      delete lc;
+      _layoutValid = false;
+      }
+
+//---------------------------------------------------------
+//   startLayoutRange
+//    set up lc to lay out the range st - et
+//    return false if the layout is done already
+//---------------------------------------------------------
 
+bool Score::startLayoutRange(LayoutContext& lc, const Fraction& st, const Fraction& et)
+      {
       Fraction stick(st);
       Fraction etick(et);
       Q_ASSERT(!(stick == Fraction(-1,1) && etick == Fraction(-1,1)));
@@ -4890,7 +5007,7 @@ void Score::doLayoutRange(const Fraction& st, const Fraction& et)
             qDeleteAll(pages());
             pages().clear();
             lc.getNextPage();
-            return;
+            return false;
             }
 //      if (!_systems.isEmpty())
 //            return;
@@ -4946,7 +5063,7 @@ void Score::doLayoutRange(const Fraction& st, const Fraction& et)
             lc.nextMeasure = m;     //_showVBox ? first() : firstMeasure();
             lc.startTick   = m->tick();
             layoutLinear(layoutAll, lc);
-            return;
+            return false;
             }
       if (!layoutAll && m->system()) {
             System* system  = m->system();
@@ -5023,8 +5140,7 @@ void Score::doLayoutRange(const Fraction& st, const Fraction& et)
 
       getNextMeasure(lc);
       lc.curSystem = collectSystem(lc);
-
-      lc.layout();
+      return true;
       }
 
 //---------------------------------------------------------
@@ -5033,28 +5149,48 @@ void Score::doLayoutRange(const Fraction& st, const Fraction& et)
 
 void LayoutContext::layout()
       {
+      while (layoutNextPage())
+            ;
+      layoutDone();
+      }
+
+//---------------------------------------------------------
+//   layoutNextPage
+//    collect the next page
+//    return false if no more pages need to be collected
+//---------------------------------------------------------
+
+bool LayoutContext::layoutNextPage()
+      {
+      getNextPage();
+      collectPage();
+
       MeasureBase* lmb;
-      do {
-            getNextPage();
-            collectPage();
+      if (page && !page->systems().isEmpty())
+            lmb = page->systems().back()->measures().back();
+      else
+            lmb = nullptr;
+
+      // we can stop collecting pages when:
+      // 1) we reach the end of score (curSystem is nullptr)
+      // or
+      // 2) we have fully processed the range and reached a point of stability:
+      //    a) we have completed layout for the range (rangeDone is true)
+      //    b) we haven't collected a system that will need to go on the next page
+      //    c) this page ends with the same measure as the previous layout
+      //    pageOldMeasure will be last measure from previous layout if range was completed on or before this page
+      //    it will be nullptr if this page was never laid out or if we collected a system for next page
+      return curSystem && !(rangeDone && lmb == pageOldMeasure);
+      // && page->system(0)->measures().back()->tick() > endTick // FIXME: perhaps the first measure was meant? Or last system?
+      }
 
-            if (page && !page->systems().isEmpty())
-                  lmb = page->systems().back()->measures().back();
-            else
-                  lmb = nullptr;
-
-            // we can stop collecting pages when:
-            // 1) we reach the end of score (curSystem is nullptr)
-            // or
-            // 2) we have fully processed the range and reached a point of stability:
-            //    a) we have completed layout for the range (rangeDone is true)
-            //    b) we haven't collected a system that will need to go on the next page
-            //    c) this page ends with the same measure as the previous layout
-            //    pageOldMeasure will be last measure from previous layout if range was completed on or before this page
-            //    it will be nullptr if this page was never laid out or if we collected a system for next page
-            } while (curSystem && !(rangeDone && lmb == pageOldMeasure));
-            // && page->system(0)->measures().back()->tick() > endTick // FIXME: perhaps the first measure was meant? Or last system?
+//---------------------------------------------------------
+//   layoutDone
+//    remove what the layout did not use
+//---------------------------------------------------------
 
+void LayoutContext::layoutDone()
+      {
       if (!curSystem) {
             // The end of the score. The remaining systems are not needed...
             qDeleteAll(systemList);
@@ -110,6 +110,8 @@ struct LayoutContext {
       void layoutLinear();
 
       void layout();
+      bool layoutNextPage();
+      void layoutDone();
       int adjustMeasureNo(MeasureBase*);
       void getNextPage();
       void collectPage();
@@ -0,0 +1,150 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  Copyright (C) 2020 Werner Schweer
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2
+//  as published by the Free Software Foundation and appearing in
+//  the file LICENCE.GPL
+//=============================================================================
+
+#include "layoutprofile.h"
+#include "measurebase.h"
+#include "mscore.h"
+#include "score.h"
+
+namespace Ms {
+
+LayoutTimer* LayoutTimer::_current = 0;
+
+//---------------------------------------------------------
+//   phaseName
+//---------------------------------------------------------
+
+const char* LayoutProfile::phaseName(Phase p)
+      {
+      static const char* names[] = {
+            "layout",
+            "getNextMeasure", "createBeams", "layoutChords1", "layoutChords3",
+            "collectSystem", "hideEmptyStaves", "layoutSystemElements", "spanners", "layoutLyrics",
+            "collectPage", "layoutPage", "distributeStaves"
+            };
+      static_assert(sizeof(names) / sizeof(*names) == int(Phase::PHASES), "a layout phase without name");
+      return names[int(p)];
+      }
+
+//---------------------------------------------------------
+//   add
+//---------------------------------------------------------
+
+void LayoutProfile::add(Phase p, qint64 nsecs, qint64 selfNsecs)
+      {
+      Total& t = _totals[int(p)];
+      t.nsecs     += nsecs;
+      t.selfNsecs += selfNsecs;
+      ++t.calls;
+      }
+
+//---------------------------------------------------------
+//   addSlowest
+//    keep the SLOWEST slowest items, a measure laid out
+//    again replaces its entry if it was slower this time
+//---------------------------------------------------------
+
+void LayoutProfile::addSlowest(std::vector<Item>& items, const MeasureBase* m, qint64 nsecs)
+      {
+      if (!m)
+            return;
+      const int tick = m->tick().ticks();
+      auto i = std::find_if(items.begin(), items.end(), [tick](const Item& item) { return item.tick == tick; });
+      if (i != items.end()) {
+            if (i->nsecs >= nsecs)
+                  return;
+            items.erase(i);
+            }
+      else if (int(items.size()) >= SLOWEST) {
+            if (items.back().nsecs >= nsecs)
+                  return;
+            items.pop_back();
+            }
+      Item item { tick, m->no(), nsecs };
+      items.insert(std::upper_bound(items.begin(), items.end(), item, [](const Item& a, const Item& b) { return a.nsecs > b.nsecs; }), item);
+      }
+
+//---------------------------------------------------------
+//   toJson
+//    times are in milliseconds, "ms" includes the phases
+//    called from a phase, "selfMs" does not
+//---------------------------------------------------------
+
+QJsonObject LayoutProfile::toJson() const
+      {
+      auto ms = [](qint64 nsecs) { return double(nsecs) / 1000000.0; };
+
+      QJsonObject phases;
+      for (int i = 0; i < int(Phase::PHASES); ++i) {
+            const Total& t = _totals[i];
+            QJsonObject o;
+            o.insert("ms", ms(t.nsecs));
+            o.insert("selfMs", ms(t.selfNsecs));
+            o.insert("calls", t.calls);
+            phases.insert(phaseName(Phase(i)), o);
+            }
+
+      auto items = [&ms](const std::vector<Item>& list) {
+            QJsonArray a;
+            for (const Item& item : list) {
+                  QJsonObject o;
+                  o.insert("measure", item.no + 1);
+                  o.insert("tick", item.tick);
+                  o.insert("ms", ms(item.nsecs));
+                  a.append(o);
+                  }
+            return a;
+            };
+
+      QJsonObject json;
+      json.insert("phases", phases);
+      json.insert("slowestMeasures", items(_measures));
+      json.insert("slowestSystems", items(_systems));
+      return json;
+      }
+
+//---------------------------------------------------------
+//   LayoutTimer
+//---------------------------------------------------------
+
+LayoutTimer::LayoutTimer(Score* score, LayoutProfile::Phase phase)
+   : _phase(phase), _parent(_current)
+      {
+      if (!MScore::profileLayout)
+            return;
+      LayoutProfile* profile = score->layoutProfile();
+      for (const LayoutTimer* t = _current; t; t = t->_parent) {
+            if (t->_profile == profile && t->_phase == phase)
+                  return;
+            }
+      _profile = profile;
+      _current = this;
+      _timer.start();
+      }
+
+LayoutTimer::~LayoutTimer()
+      {
+      if (!_profile)
+            return;
+      const qint64 nsecs = _timer.nsecsElapsed();
+      _profile->add(_phase, nsecs, nsecs - _children);
+      if (_phase == LayoutProfile::Phase::GET_NEXT_MEASURE)
+            _profile->addMeasure(_measure, nsecs);
+      else if (_phase == LayoutProfile::Phase::COLLECT_SYSTEM)
+            _profile->addSystem(_measure, nsecs);
+      _current = _parent;
+      if (_parent)
+            _parent->_children += nsecs;
+      }
+
+}     // namespace Ms
+
@@ -0,0 +1,95 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  Copyright (C) 2020 Werner Schweer
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2
+//  as published by the Free Software Foundation and appearing in
+//  the file LICENCE.GPL
+//=============================================================================
+
+#ifndef __LAYOUTPROFILE_H__
+#define __LAYOUTPROFILE_H__
+
+namespace Ms {
+
+class MeasureBase;
+class Score;
+
+//---------------------------------------------------------
+//   LayoutProfile
+//    time spent by the layout of a score in its phases,
+//    collected by LayoutTimer if MScore::profileLayout is set
+//---------------------------------------------------------
+
+class LayoutProfile {
+   public:
+      enum class Phase : char {
+            LAYOUT,
+            GET_NEXT_MEASURE, CREATE_BEAMS, LAYOUT_CHORDS1, LAYOUT_CHORDS3,
+            COLLECT_SYSTEM, HIDE_EMPTY_STAVES, LAYOUT_SYSTEM_ELEMENTS, SPANNERS, LAYOUT_LYRICS,
+            COLLECT_PAGE, LAYOUT_PAGE, DISTRIBUTE_STAVES,
+            PHASES
+            };
+
+   private:
+      static const int SLOWEST = 10;      // number of measures and systems reported
+
+      struct Total {
+            qint64 nsecs     { 0 };       // including the phases called from this one
+            qint64 selfNsecs { 0 };
+            int calls        { 0 };
+            };
+
+      struct Item {                       // a measure, or the first measure of a system
+            int tick;
+            int no;
+            qint64 nsecs;
+            };
+
+      Total _totals[int(Phase::PHASES)];
+      std::vector<Item> _measures;        // the slowest ones, slowest first
+      std::vector<Item> _systems;
+
+      static void addSlowest(std::vector<Item>&, const MeasureBase*, qint64 nsecs);
+
+   public:
+      void add(Phase, qint64 nsecs, qint64 selfNsecs);
+      void addMeasure(const MeasureBase* m, qint64 nsecs) { addSlowest(_measures, m, nsecs); }
+      void addSystem(const MeasureBase* m, qint64 nsecs)  { addSlowest(_systems, m, nsecs);  }
+      QJsonObject toJson() const;
+
+      static const char* phaseName(Phase);
+      };
+
+//---------------------------------------------------------
+//   LayoutTimer
+//    adds the time spent in its scope to a phase of the
+//    layout profile of the score; a phase nested in the
+//    same phase is not counted twice
+//---------------------------------------------------------
+
+class LayoutTimer {
+      LayoutProfile* _profile { 0 };      // 0 if not timing
+      LayoutProfile::Phase _phase;
+      LayoutTimer* _parent;
+      QElapsedTimer _timer;
+      qint64 _children { 0 };             // time spent in nested timers
+      const MeasureBase* _measure { 0 };
+
+      static LayoutTimer* _current;
+
+   public:
+      LayoutTimer(Score*, LayoutProfile::Phase);
+      ~LayoutTimer();
+      LayoutTimer(const LayoutTimer&) = delete;
+      LayoutTimer& operator=(const LayoutTimer&) = delete;
+
+      void setMeasure(const MeasureBase* m) { _measure = m; }   // the measure or system timed
+      };
+
+}     // namespace Ms
+#endif
+
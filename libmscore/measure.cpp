@@ -2028,99 +2028,113 @@ void Measure::read(XmlReader& e, int staffIdx)
             irregular = false;
 
       while (e.readNextStartElement()) {
-            const QStringRef& tag(e.name());
-
-            if (tag == "voice") {
-                  e.setTrack(nextTrack++);
-                  e.setTick(tick());
-                  readVoice(e, staffIdx, irregular);
-                  }
-            else if (tag == "Marker" || tag == "Jump") {
-                  Element* el = Element::name2Element(tag, score());
-                  el->setTrack(e.track());
-                  el->read(e);
-                  add(el);
-                  }
-            else if (tag == "stretch") {
-                  double val = e.readDouble();
-                  if (val < 0.0)
-                        val = 0;
-                  setUserStretch(val);
-                  }
-            else if (tag == "noOffset")
-                  setNoOffset(e.readInt());
-            else if (tag == "measureNumberMode")
-                  setMeasureNumberMode(MeasureNumberMode(e.readInt()));
-            else if (tag == "irregular")
-                  setIrregular(e.readBool());
-            else if (tag == "breakMultiMeasureRest")
-                  _breakMultiMeasureRest = e.readBool();
-            else if (tag == "startRepeat") {
-                  setRepeatStart(true);
-                  e.readNext();
-                  }
-            else if (tag == "endRepeat") {
-                  _repeatCount = e.readInt();
-                  setRepeatEnd(true);
-                  }
-            else if (tag == "vspacer" || tag == "vspacerDown") {
-                  if (!_mstaves[staffIdx]->vspacerDown()) {
-                        Spacer* spacer = new Spacer(score());
-                        spacer->setSpacerType(SpacerType::DOWN);
-                        spacer->setTrack(staffIdx * VOICES);
-                        add(spacer);
+            switch (e.tag()) {
+                  case XmlTag::VOICE:
+                        e.setTrack(nextTrack++);
+                        e.setTick(tick());
+                        readVoice(e, staffIdx, irregular);
+                        break;
+                  case XmlTag::MARKER:
+                  case XmlTag::JUMP: {
+                        Element* el = Element::name2Element(e.name(), score());
+                        el->setTrack(e.track());
+                        el->read(e);
+                        add(el);
                         }
-                  _mstaves[staffIdx]->vspacerDown()->setGap(e.readDouble() * _spatium);
-                  }
-            else if (tag == "vspacerFixed") {
-                  if (!_mstaves[staffIdx]->vspacerDown()) {
-                        Spacer* spacer = new Spacer(score());
-                        spacer->setSpacerType(SpacerType::FIXED);
-                        spacer->setTrack(staffIdx * VOICES);
-                        add(spacer);
+                        break;
+                  case XmlTag::STRETCH: {
+                        double val = e.readDouble();
+                        if (val < 0.0)
+                              val = 0;
+                        setUserStretch(val);
                         }
-                  _mstaves[staffIdx]->vspacerDown()->setGap(e.readDouble() * _spatium);
-                  }
-            else if (tag == "vspacerUp") {
-                  if (!_mstaves[staffIdx]->vspacerUp()) {
-                        Spacer* spacer = new Spacer(score());
-                        spacer->setSpacerType(SpacerType::UP);
-                        spacer->setTrack(staffIdx * VOICES);
-                        add(spacer);
+                        break;
+                  case XmlTag::NO_OFFSET:
+                        setNoOffset(e.readInt());
+                        break;
+                  case XmlTag::MEASURE_NUMBER_MODE:
+                        setMeasureNumberMode(MeasureNumberMode(e.readInt()));
+                        break;
+                  case XmlTag::IRREGULAR:
+                        setIrregular(e.readBool());
+                        break;
+                  case XmlTag::BREAK_MULTI_MEASURE_REST:
+                        _breakMultiMeasureRest = e.readBool();
+                        break;
+                  case XmlTag::START_REPEAT:
+                        setRepeatStart(true);
+                        e.readNext();
+                        break;
+                  case XmlTag::END_REPEAT:
+                        _repeatCount = e.readInt();
+                        setRepeatEnd(true);
+                        break;
+                  case XmlTag::VSPACER:
+                  case XmlTag::VSPACER_DOWN:
+                        if (!_mstaves[staffIdx]->vspacerDown()) {
+                              Spacer* spacer = new Spacer(score());
+                              spacer->setSpacerType(SpacerType::DOWN);
+                              spacer->setTrack(staffIdx * VOICES);
+                              add(spacer);
+                              }
+                        _mstaves[staffIdx]->vspacerDown()->setGap(e.readDouble() * _spatium);
+                        break;
+                  case XmlTag::VSPACER_FIXED:
+                        if (!_mstaves[staffIdx]->vspacerDown()) {
+                              Spacer* spacer = new Spacer(score());
+                              spacer->setSpacerType(SpacerType::FIXED);
+                              spacer->setTrack(staffIdx * VOICES);
+                              add(spacer);
+                              }
+                        _mstaves[staffIdx]->vspacerDown()->setGap(e.readDouble() * _spatium);
+                        break;
+                  case XmlTag::VSPACER_UP:
+                        if (!_mstaves[staffIdx]->vspacerUp()) {
+                              Spacer* spacer = new Spacer(score());
+                              spacer->setSpacerType(SpacerType::UP);
+                              spacer->setTrack(staffIdx * VOICES);
+                              add(spacer);
+                              }
+                        _mstaves[staffIdx]->vspacerUp()->setGap(e.readDouble() * _spatium);
+                        break;
+                  case XmlTag::VISIBLE:
+                        _mstaves[staffIdx]->setVisible(e.readInt());
+                        break;
+                  case XmlTag::SLASH_STYLE:
+                  case XmlTag::STEMLESS:
+                        _mstaves[staffIdx]->setStemless(e.readInt());
+                        break;
+                  case XmlTag::SYSTEM_DIVIDER: {
+                        SystemDivider* sd = new SystemDivider(score());
+                        sd->read(e);
+                        add(sd);
                         }
-                  _mstaves[staffIdx]->vspacerUp()->setGap(e.readDouble() * _spatium);
-                  }
-            else if (tag == "visible")
-                  _mstaves[staffIdx]->setVisible(e.readInt());
-            else if ((tag == "slashStyle") || (tag == "stemless"))
-                  _mstaves[staffIdx]->setStemless(e.readInt());
-            else if (tag == "SystemDivider") {
-                  SystemDivider* sd = new SystemDivider(score());
-                  sd->read(e);
-                  add(sd);
-                  }
-            else if (tag == "multiMeasureRest") {
-                  _mmRestCount = e.readInt();
-                  // set tick to previous measure
-                  setTick(e.lastMeasure()->tick());
-                  e.setTick(e.lastMeasure()->tick());
-                  }
-            else if (tag == "MeasureNumber") {
-                  MeasureNumber* noText = new MeasureNumber(score());
-                  noText->read(e);
-                  noText->setTrack(e.track());
-                  add(noText);
-                  }
-            else if (tag == "MMRestRange") {
-                  MMRestRange* range = new MMRestRange(score());
-                  range->read(e);
-                  range->setTrack(e.track());
-                  add(range);
+                        break;
+                  case XmlTag::MULTI_MEASURE_REST:
+                        _mmRestCount = e.readInt();
+                        // set tick to previous measure
+                        setTick(e.lastMeasure()->tick());
+                        e.setTick(e.lastMeasure()->tick());
+                        break;
+                  case XmlTag::MEASURE_NUMBER: {
+                        MeasureNumber* noText = new MeasureNumber(score());
+                        noText->read(e);
+                        noText->setTrack(e.track());
+                        add(noText);
+                        }
+                        break;
+                  case XmlTag::MM_REST_RANGE: {
+                        MMRestRange* range = new MMRestRange(score());
+                        range->read(e);
+                        range->setTrack(e.track());
+                        add(range);
+                        }
+                        break;
+                  default:
+                        if (!MeasureBase::readProperties(e))
+                              e.unknown();
+                        break;
                   }
-            else if (MeasureBase::readProperties(e))
-                  ;
-            else
-                  e.unknown();
             }
       e.checkConnectors();
       if (isMMRest()) {
@@ -2148,313 +2162,334 @@ void Measure::readVoice(XmlReader& e, int staffIdx, bool irregular)
       Fraction timeStretch(staff->timeStretch(tick()));
 
       while (e.readNextStartElement()) {
-            const QStringRef& tag(e.name());
-
-            if (tag == "location") {
-                  Location loc = Location::relative();
-                  loc.read(e);
-                  e.setLocation(loc);
-                  }
-            else if (tag == "tick") {           // obsolete?
-                  qDebug("read midi tick");
-                  e.setTick(Fraction::fromTicks(score()->fileDivision(e.readInt())));
-                  }
-            else if (tag == "BarLine") {
-                  BarLine* barLine = new BarLine(score());
-                  barLine->setTrack(e.track());
-                  barLine->read(e);
-                  //
-                  //  StartRepeatBarLine: at rtick == 0, always BarLineType::START_REPEAT
-                  //  BarLine:            in the middle of a measure, has no semantic
-                  //  EndBarLine:         at the end of a measure
-                  //  BeginBarLine:       first segment of a measure, systemic barline
-
-                  SegmentType st = SegmentType::Invalid;
-                  Fraction t = e.tick() - tick();
-                  if (t.isNotZero() && (t != ticks()))
-                        st = SegmentType::BarLine;
-                  else if (barLine->barLineType() == BarLineType::START_REPEAT && t.isZero())
-                        st = SegmentType::StartRepeatBarLine;
-                  else if (barLine->barLineType() == BarLineType::START_REPEAT && t == ticks()) {
-                        // old version, ignore
-                        delete barLine;
-                        barLine = 0;
+            switch (e.tag()) {
+                  case XmlTag::LOCATION: {
+                        Location loc = Location::relative();
+                        loc.read(e);
+                        e.setLocation(loc);
                         }
-                  else if (t.isZero() && segment == 0)
-                        st = SegmentType::BeginBarLine;
-                  else
-                        st = SegmentType::EndBarLine;
-                  if (barLine) {
-                        segment = getSegmentR(st, t);
-                        segment->add(barLine);
-                        barLine->layout();
-                        }
-                  if (fermata) {
-                        segment->add(fermata);
-                        fermata = nullptr;
+                        break;
+                  case XmlTag::TICK:            // obsolete?
+                        qDebug("read midi tick");
+                        e.setTick(Fraction::fromTicks(score()->fileDivision(e.readInt())));
+                        break;
+                  case XmlTag::BAR_LINE: {
+                        BarLine* barLine = new BarLine(score());
+                        barLine->setTrack(e.track());
+                        barLine->read(e);
+                        //
+                        //  StartRepeatBarLine: at rtick == 0, always BarLineType::START_REPEAT
+                        //  BarLine:            in the middle of a measure, has no semantic
+                        //  EndBarLine:         at the end of a measure
+                        //  BeginBarLine:       first segment of a measure, systemic barline
+
+                        SegmentType st = SegmentType::Invalid;
+                        Fraction t = e.tick() - tick();
+                        if (t.isNotZero() && (t != ticks()))
+                              st = SegmentType::BarLine;
+                        else if (barLine->barLineType() == BarLineType::START_REPEAT && t.isZero())
+                              st = SegmentType::StartRepeatBarLine;
+                        else if (barLine->barLineType() == BarLineType::START_REPEAT && t == ticks()) {
+                              // old version, ignore
+                              delete barLine;
+                              barLine = 0;
+                              }
+                        else if (t.isZero() && segment == 0)
+                              st = SegmentType::BeginBarLine;
+                        else
+                              st = SegmentType::EndBarLine;
+                        if (barLine) {
+                              segment = getSegmentR(st, t);
+                              segment->add(barLine);
+                              barLine->layout();
+                              }
+                        if (fermata) {
+                              segment->add(fermata);
+                              fermata = nullptr;
+                              }
                         }
-                  }
-            else if (tag == "Chord") {
-                  Chord* chord = new Chord(score());
-                  chord->setTrack(e.track());
-                  chord->read(e);
-                  if (startingBeam) {
-                        startingBeam->add(chord); // also calls chord->setBeam(startingBeam)
-                        startingBeam = nullptr;
+                        break;
+                  case XmlTag::CHORD: {
+                        Chord* chord = new Chord(score());
+                        chord->setTrack(e.track());
+                        chord->read(e);
+                        if (startingBeam) {
+                              startingBeam->add(chord); // also calls chord->setBeam(startingBeam)
+                              startingBeam = nullptr;
+                              }
+//                        if (tuplet && !chord->isGrace())
+//                              chord->readAddTuplet(tuplet);
+                        segment = getSegment(SegmentType::ChordRest, e.tick());
+                        if (chord->noteType() != NoteType::NORMAL)
+                              graceNotes.push_back(chord);
+                        else {
+                              segment->add(chord);
+                              for (int i = 0; i < graceNotes.size(); ++i) {
+                                    Chord* gc = graceNotes[i];
+                                    gc->setGraceIndex(i);
+                                    chord->add(gc);
+                                    }
+                              graceNotes.clear();
+                              if (tuplet)
+                                    tuplet->add(chord);
+                              e.incTick(chord->actualTicks());
+                              }
+                        if (fermata) {
+                              segment->add(fermata);
+                              fermata = nullptr;
+                              }
                         }
-//                  if (tuplet && !chord->isGrace())
-//                        chord->readAddTuplet(tuplet);
-                  segment = getSegment(SegmentType::ChordRest, e.tick());
-                  if (chord->noteType() != NoteType::NORMAL)
-                        graceNotes.push_back(chord);
-                  else {
-                        segment->add(chord);
-                        for (int i = 0; i < graceNotes.size(); ++i) {
-                              Chord* gc = graceNotes[i];
-                              gc->setGraceIndex(i);
-                              chord->add(gc);
+                        break;
+                  case XmlTag::REST: {
+                        Rest* rest = new Rest(score());
+                        rest->setDurationType(TDuration::DurationType::V_MEASURE);
+                        rest->setTicks(timesig()/timeStretch);
+                        rest->setTrack(e.track());
+                        rest->read(e);
+                        if (startingBeam) {
+                              startingBeam->add(rest); // also calls rest->setBeam(startingBeam)
+                              startingBeam = nullptr;
+                              }
+                        segment = getSegment(SegmentType::ChordRest, e.tick());
+                        segment->add(rest);
+                        if (fermata) {
+                              segment->add(fermata);
+                              fermata = nullptr;
                               }
-                        graceNotes.clear();
+
+                        if (!rest->ticks().isValid())     // hack
+                              rest->setTicks(timesig()/timeStretch);
+
                         if (tuplet)
-                              tuplet->add(chord);
-                        e.incTick(chord->actualTicks());
+                              tuplet->add(rest);
+                        e.incTick(rest->actualTicks());
                         }
-                  if (fermata) {
-                        segment->add(fermata);
-                        fermata = nullptr;
+                        break;
+                  case XmlTag::BREATH: {
+                        Breath* breath = new Breath(score());
+                        breath->setTrack(e.track());
+                        breath->setPlacement(breath->track() & 1 ? Placement::BELOW : Placement::ABOVE);
+                        breath->read(e);
+                        segment = getSegment(SegmentType::Breath, e.tick());
+                        segment->add(breath);
                         }
-                  }
-            else if (tag == "Rest") {
-                  Rest* rest = new Rest(score());
-                  rest->setDurationType(TDuration::DurationType::V_MEASURE);
-                  rest->setTicks(timesig()/timeStretch);
-                  rest->setTrack(e.track());
-                  rest->read(e);
-                  if (startingBeam) {
-                        startingBeam->add(rest); // also calls rest->setBeam(startingBeam)
-                        startingBeam = nullptr;
+                        break;
+                  case XmlTag::SPANNER:
+                        Spanner::readSpanner(e, this, e.track());
+                        break;
+                  case XmlTag::REPEAT_MEASURE: {
+                        RepeatMeasure* rm = new RepeatMeasure(score());
+                        rm->setTrack(e.track());
+                        rm->read(e);
+                        segment = getSegment(SegmentType::ChordRest, e.tick());
+                        segment->add(rm);
+                        e.incTick(ticks());
                         }
-                  segment = getSegment(SegmentType::ChordRest, e.tick());
-                  segment->add(rest);
-                  if (fermata) {
-                        segment->add(fermata);
-                        fermata = nullptr;
+                        break;
+                  case XmlTag::CLEF: {
+                        Clef* clef = new Clef(score());
+                        clef->setTrack(e.track());
+                        clef->read(e);
+                        clef->setGenerated(false);
+
+                        // there may be more than one clef segment for same tick position
+                        // the first clef may be missing and is added later in layout
+
+                        bool header;
+                        if (e.tick() != tick())
+                              header = false;
+                        else if (!segment)
+                              header = true;
+                        else {
+                              header = true;
+                              for (Segment* s = _segments.first(); s && s->rtick().isZero(); s = s->next()) {
+                                    if (s->isKeySigType() || s->isTimeSigType()) {
+                                          // hack: there may be other segment types which should
+                                          // generate a clef at current position
+                                          header = false;
+                                          break;
+                                          }
+                                    }
+                              }
+                        segment = getSegment(header ? SegmentType::HeaderClef : SegmentType::Clef, e.tick());
+                        segment->add(clef);
                         }
+                        break;
+                  case XmlTag::TIME_SIG: {
+                        TimeSig* ts = new TimeSig(score());
+                        ts->setTrack(e.track());
+                        ts->read(e);
+                        // if time sig not at beginning of measure => courtesy time sig
+                        Fraction currTick = e.tick();
+                        bool courtesySig = (currTick > tick());
+                        if (courtesySig) {
+                              // if courtesy sig., just add it without map processing
+                              segment = getSegment(SegmentType::TimeSigAnnounce, currTick);
+                              segment->add(ts);
+                              }
+                        else {
+                              // if 'real' time sig., do full process
+                              segment = getSegment(SegmentType::TimeSig, currTick);
+                              segment->add(ts);
 
-                  if (!rest->ticks().isValid())     // hack
-                        rest->setTicks(timesig()/timeStretch);
+                              timeStretch = ts->stretch().reduced();
+                              _timesig    = ts->sig() / timeStretch;
 
-                  if (tuplet)
-                        tuplet->add(rest);
-                  e.incTick(rest->actualTicks());
-                  }
-            else if (tag == "Breath") {
-                  Breath* breath = new Breath(score());
-                  breath->setTrack(e.track());
-                  breath->setPlacement(breath->track() & 1 ? Placement::BELOW : Placement::ABOVE);
-                  breath->read(e);
-                  segment = getSegment(SegmentType::Breath, e.tick());
-                  segment->add(breath);
-                  }
-            else if (tag == "Spanner")
-                  Spanner::readSpanner(e, this, e.track());
-            else if (tag == "RepeatMeasure") {
-                  RepeatMeasure* rm = new RepeatMeasure(score());
-                  rm->setTrack(e.track());
-                  rm->read(e);
-                  segment = getSegment(SegmentType::ChordRest, e.tick());
-                  segment->add(rm);
-                  e.incTick(ticks());
-                  }
-            else if (tag == "Clef") {
-                  Clef* clef = new Clef(score());
-                  clef->setTrack(e.track());
-                  clef->read(e);
-                  clef->setGenerated(false);
-
-                  // there may be more than one clef segment for same tick position
-                  // the first clef may be missing and is added later in layout
-
-                  bool header;
-                  if (e.tick() != tick())
-                        header = false;
-                  else if (!segment)
-                        header = true;
-                  else {
-                        header = true;
-                        for (Segment* s = _segments.first(); s && s->rtick().isZero(); s = s->next()) {
-                              if (s->isKeySigType() || s->isTimeSigType()) {
-                                    // hack: there may be other segment types which should
-                                    // generate a clef at current position
-                                    header = false;
-                                    break;
+                              if (irregular) {
+                                    score()->sigmap()->add(tick().ticks(), SigEvent(_len, _timesig));
+                                    score()->sigmap()->add((tick() + ticks()).ticks(), SigEvent(_timesig));
+                                    }
+                              else {
+                                    _len = _timesig;
+                                    score()->sigmap()->add(tick().ticks(), SigEvent(_timesig));
                                     }
                               }
                         }
-                  segment = getSegment(header ? SegmentType::HeaderClef : SegmentType::Clef, e.tick());
-                  segment->add(clef);
-                  }
-            else if (tag == "TimeSig") {
-                  TimeSig* ts = new TimeSig(score());
-                  ts->setTrack(e.track());
-                  ts->read(e);
-                  // if time sig not at beginning of measure => courtesy time sig
-                  Fraction currTick = e.tick();
-                  bool courtesySig = (currTick > tick());
-                  if (courtesySig) {
-                        // if courtesy sig., just add it without map processing
-                        segment = getSegment(SegmentType::TimeSigAnnounce, currTick);
-                        segment->add(ts);
-                        }
-                  else {
-                        // if 'real' time sig., do full process
-                        segment = getSegment(SegmentType::TimeSig, currTick);
-                        segment->add(ts);
-
-                        timeStretch = ts->stretch().reduced();
-                        _timesig    = ts->sig() / timeStretch;
-
-                        if (irregular) {
-                              score()->sigmap()->add(tick().ticks(), SigEvent(_len, _timesig));
-                              score()->sigmap()->add((tick() + ticks()).ticks(), SigEvent(_timesig));
+                        break;
+                  case XmlTag::KEY_SIG: {
+                        KeySig* ks = new KeySig(score());
+                        ks->setTrack(e.track());
+                        ks->read(e);
+                        Fraction curTick = e.tick();
+                        if (!ks->isCustom() && !ks->isAtonal() && ks->key() == Key::C && curTick.isZero()) {
+                              // ignore empty key signature
+                              qDebug("remove keysig c at tick 0");
                               }
                         else {
-                              _len = _timesig;
-                              score()->sigmap()->add(tick().ticks(), SigEvent(_timesig));
+                              // if key sig not at beginning of measure => courtesy key sig
+                              bool courtesySig = (curTick == endTick());
+                              segment = getSegment(courtesySig ? SegmentType::KeySigAnnounce : SegmentType::KeySig, curTick);
+                              segment->add(ks);
+                              if (!courtesySig)
+                                    staff->setKey(curTick, ks->keySigEvent());
                               }
                         }
-                  }
-            else if (tag == "KeySig") {
-                  KeySig* ks = new KeySig(score());
-                  ks->setTrack(e.track());
-                  ks->read(e);
-                  Fraction curTick = e.tick();
-                  if (!ks->isCustom() && !ks->isAtonal() && ks->key() == Key::C && curTick.isZero()) {
-                        // ignore empty key signature
-                        qDebug("remove keysig c at tick 0");
-                        }
-                  else {
-                        // if key sig not at beginning of measure => courtesy key sig
-                        bool courtesySig = (curTick == endTick());
-                        segment = getSegment(courtesySig ? SegmentType::KeySigAnnounce : SegmentType::KeySig, curTick);
-                        segment->add(ks);
-                        if (!courtesySig)
-                              staff->setKey(curTick, ks->keySigEvent());
-                        }
-                  }
-            else if (tag == "Text") {
-                  StaffText* t = new StaffText(score());
-                  t->setTrack(e.track());
-                  t->read(e);
-                  if (t->empty()) {
-                        qDebug("==reading empty text: deleted");
-                        delete t;
-                        }
-                  else {
-                        segment = getSegment(SegmentType::ChordRest, e.tick());
-                        segment->add(t);
+                        break;
+                  case XmlTag::TEXT: {
+                        StaffText* t = new StaffText(score());
+                        t->setTrack(e.track());
+                        t->read(e);
+                        if (t->empty()) {
+                              qDebug("==reading empty text: deleted");
+                              delete t;
+                              }
+                        else {
+                              segment = getSegment(SegmentType::ChordRest, e.tick());
+                              segment->add(t);
+                              }
                         }
-                  }
+                        break;
 
-            //----------------------------------------------------
-            // Annotation
+                  //----------------------------------------------------
+                  // Annotation
 
-            else if (tag == "Dynamic") {
-                  Dynamic* dyn = new Dynamic(score());
-                  dyn->setTrack(e.track());
-                  dyn->read(e);
-                  segment = getSegment(SegmentType::ChordRest, e.tick());
-                  segment->add(dyn);
-                  }
-            else if (tag == "Harmony"
-               || tag == "FretDiagram"
-               || tag == "TremoloBar"
-               || tag == "Symbol"
-               || tag == "Tempo"
-               || tag == "StaffText"
-               || tag == "Sticking"
-               || tag == "SystemText"
-               || tag == "RehearsalMark"
-               || tag == "InstrumentChange"
-               || tag == "StaffState"
-               || tag == "FiguredBass"
-               ) {
-                  Element* el = Element::name2Element(tag, score());
-                  // hack - needed because tick tags are unreliable in 1.3 scores
-                  // for symbols attached to anything but a measure
-                  el->setTrack(e.track());
-                  el->read(e);
-                  segment = getSegment(SegmentType::ChordRest, e.tick());
-                  segment->add(el);
-                  }
-            else if (tag == "Fermata") {
-                  fermata = new Fermata(score());
-                  fermata->setTrack(e.track());
-                  fermata->setPlacement(fermata->track() & 1 ? Placement::BELOW : Placement::ABOVE);
-                  fermata->read(e);
-                  }
-            else if (tag == "Image") {
-                  if (MScore::noImages)
-                        e.skipCurrentElement();
-                  else {
-                        Element* el = Element::name2Element(tag, score());
+                  case XmlTag::DYNAMIC: {
+                        Dynamic* dyn = new Dynamic(score());
+                        dyn->setTrack(e.track());
+                        dyn->read(e);
+                        segment = getSegment(SegmentType::ChordRest, e.tick());
+                        segment->add(dyn);
+                        }
+                        break;
+                  case XmlTag::HARMONY:
+                  case XmlTag::FRET_DIAGRAM:
+                  case XmlTag::TREMOLO_BAR:
+                  case XmlTag::SYMBOL:
+                  case XmlTag::TEMPO:
+                  case XmlTag::STAFF_TEXT:
+                  case XmlTag::STICKING:
+                  case XmlTag::SYSTEM_TEXT:
+                  case XmlTag::REHEARSAL_MARK:
+                  case XmlTag::INSTRUMENT_CHANGE:
+                  case XmlTag::STAFF_STATE:
+                  case XmlTag::FIGURED_BASS: {
+                        Element* el = Element::name2Element(e.name(), score());
+                        // hack - needed because tick tags are unreliable in 1.3 scores
+                        // for symbols attached to anything but a measure
                         el->setTrack(e.track());
                         el->read(e);
                         segment = getSegment(SegmentType::ChordRest, e.tick());
                         segment->add(el);
                         }
-                  }
-            //----------------------------------------------------
-            else if (tag == "Tuplet") {
-                  Tuplet* oldTuplet = tuplet;
-                  tuplet = new Tuplet(score());
-                  tuplet->setTrack(e.track());
-                  tuplet->setTick(e.tick());
-                  tuplet->setParent(this);
-                  tuplet->read(e);
-                  if (oldTuplet)
-                        oldTuplet->add(tuplet);
-                  }
-            else if (tag == "endTuplet") {
-                  if (!tuplet) {
-                        qDebug("Measure::read: encountered <endTuplet/> when no tuplet was started");
-                        e.skipCurrentElement();
-                        continue;
+                        break;
+                  case XmlTag::FERMATA:
+                        fermata = new Fermata(score());
+                        fermata->setTrack(e.track());
+                        fermata->setPlacement(fermata->track() & 1 ? Placement::BELOW : Placement::ABOVE);
+                        fermata->read(e);
+                        break;
+                  case XmlTag::IMAGE:
+                        if (MScore::noImages)
+                              e.skipCurrentElement();
+                        else {
+                              Element* el = Element::name2Element(e.name(), score());
+                              el->setTrack(e.track());
+                              el->read(e);
+                              segment = getSegment(SegmentType::ChordRest, e.tick());
+                              segment->add(el);
+                              }
+                        break;
+                  //----------------------------------------------------
+                  case XmlTag::TUPLET: {
+                        Tuplet* oldTuplet = tuplet;
+                        tuplet = new Tuplet(score());
+                        tuplet->setTrack(e.track());
+                        tuplet->setTick(e.tick());
+                        tuplet->setParent(this);
+                        tuplet->read(e);
+                        if (oldTuplet)
+                              oldTuplet->add(tuplet);
                         }
-                  Tuplet* oldTuplet = tuplet;
-                  tuplet = tuplet->tuplet();
-                  if (oldTuplet->elements().empty()) {
-                        // this should not happen and is a sign of input file corruption
-                        qDebug("Measure:read: empty tuplet in measure index=%d, input file corrupted?", e.currentMeasureIndex());
-                        if (tuplet)
-                              tuplet->remove(oldTuplet);
-                        delete oldTuplet;
+                        break;
+                  case XmlTag::END_TUPLET: {
+                        if (!tuplet) {
+                              qDebug("Measure::read: encountered <endTuplet/> when no tuplet was started");
+                              e.skipCurrentElement();
+                              break;
+                              }
+                        Tuplet* oldTuplet = tuplet;
+                        tuplet = tuplet->tuplet();
+                        if (oldTuplet->elements().empty()) {
+                              // this should not happen and is a sign of input file corruption
+                              qDebug("Measure:read: empty tuplet in measure index=%d, input file corrupted?", e.currentMeasureIndex());
+                              if (tuplet)
+                                    tuplet->remove(oldTuplet);
+                              delete oldTuplet;
+                              }
+                        e.readNext();
                         }
-                  e.readNext();
-                  }
-            else if (tag == "Beam") {
-                  Beam* beam = new Beam(score());
-                  beam->setTrack(e.track());
-                  beam->read(e);
-                  beam->setParent(0);
-                  if (startingBeam) {
-                        qDebug("The read beam was not used");
-                        delete startingBeam;
+                        break;
+                  case XmlTag::BEAM: {
+                        Beam* beam = new Beam(score());
+                        beam->setTrack(e.track());
+                        beam->read(e);
+                        beam->setParent(0);
+                        if (startingBeam) {
+                              qDebug("The read beam was not used");
+                              delete startingBeam;
+                              }
+                        startingBeam = beam;
                         }
-                  startingBeam = beam;
-                  }
-            else if (tag == "Segment" && segment)
-                  segment->read(e);
-            else if (tag == "Ambitus") {
-                  Ambitus* range = new Ambitus(score());
-                  range->read(e);
-                  segment = getSegment(SegmentType::Ambitus, e.tick());
-                  range->setParent(segment);          // a parent segment is needed for setTrack() to work
-                  range->setTrack(trackZeroVoice(e.track()));
-                  segment->add(range);
+                        break;
+                  case XmlTag::SEGMENT:
+                        if (segment)
+                              segment->read(e);
+                        else
+                              e.unknown();
+                        break;
+                  case XmlTag::AMBITUS: {
+                        Ambitus* range = new Ambitus(score());
+                        range->read(e);
+                        segment = getSegment(SegmentType::Ambitus, e.tick());
+                        range->setParent(segment);          // a parent segment is needed for setTrack() to work
+                        range->setTrack(trackZeroVoice(e.track()));
+                        segment->add(range);
+                        }
+                        break;
+                  default:
+                        e.unknown();
+                        break;
                   }
-            else
-                  e.unknown();
             }
       if (startingBeam) {
             qDebug("The read beam was not used");
@@ -3345,6 +3380,16 @@ Measure* Measure::mmRestLast() const
       return score()->lastMeasure();
       }
 
+//---------------------------------------------------------
+//   setMMRest
+//---------------------------------------------------------
+
+void Measure::setMMRest(Measure* m)
+      {
+      _mmRest = m;
+      score()->measures()->changed();     // the measures along nextMeasureMM() changed
+      }
+
 //---------------------------------------------------------
 //   mmRest1
 //    return the multi measure rest this measure is covered
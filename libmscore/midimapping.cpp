@@ -140,6 +140,8 @@ int MasterScore::getNextFreeDrumMidiMapping()
 void MasterScore::rebuildExcerptsMidiMapping()
       {
       for (Excerpt* ex : excerpts()) {
+            if (!ex->partScore())         // not read yet
+                  continue;
             for (Part* p : ex->partScore()->parts()) {
                   const Part* masterPart = p->masterPart();
                   if (!masterPart->score()->isMaster()) {
@@ -112,6 +112,8 @@ int     MScore::sampleRate  = 44100;
 int     MScore::mtcType;
 
 bool    MScore::noExcerpts = false;
+bool    MScore::deferExcerpts = false;
+bool    MScore::profileLayout = false;
 bool    MScore::noImages = false;
 bool    MScore::pdfPrinting = false;
 bool    MScore::svgPrinting = false;
@@ -374,6 +374,8 @@ class MScore {
       static bool noGui;
 
       static bool noExcerpts;
+      static bool deferExcerpts;    // read and lay out excerpts only when asked for, see MasterScore::readDeferredExcerpt()
+      static bool profileLayout;    // time the layout phases, see Score::layoutProfile()
       static bool noImages;
 
       static bool pdfPrinting;
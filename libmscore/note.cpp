@@ -1413,112 +1413,133 @@ void Note::read(XmlReader& e)
 
 bool Note::readProperties(XmlReader& e)
       {
-      const QStringRef& tag(e.name());
-
-      if (tag == "pitch")
-            _pitch = e.readInt();
-      else if (tag == "tpc") {
-            _tpc[0] = e.readInt();
-            _tpc[1] = _tpc[0];
-            }
-      else if (tag == "track")            // for performance
-            setTrack(e.readInt());
-      else if (tag == "Accidental") {
-            Accidental* a = new Accidental(score());
-            a->setTrack(track());
-            a->read(e);
-            add(a);
-            }
-      else if (tag == "Spanner")
-            Spanner::readSpanner(e, this, track());
-      else if (tag == "tpc2")
-            _tpc[1] = e.readInt();
-      else if (tag == "small")
-            setSmall(e.readInt());
-      else if (tag == "mirror")
-            readProperty(e, Pid::MIRROR_HEAD);
-      else if (tag == "dotPosition")
-            readProperty(e, Pid::DOT_POSITION);
-      else if (tag == "fixed")
-            setFixed(e.readBool());
-      else if (tag == "fixedLine")
-            setFixedLine(e.readInt());
-      else if (tag == "headScheme")
-            readProperty(e, Pid::HEAD_SCHEME);
-      else if (tag == "head")
-            readProperty(e, Pid::HEAD_GROUP);
-      else if (tag == "velocity")
-            setVeloOffset(e.readInt());
-      else if (tag == "play")
-            setPlay(e.readInt());
-      else if (tag == "tuning")
-            setTuning(e.readDouble());
-      else if (tag == "fret")
-            setFret(e.readInt());
-      else if (tag == "string")
-            setString(e.readInt());
-      else if (tag == "ghost")
-            setGhost(e.readInt());
-      else if (tag == "headType")
-            readProperty(e, Pid::HEAD_TYPE);
-      else if (tag == "veloType")
-            readProperty(e, Pid::VELO_TYPE);
-      else if (tag == "line")
-            setLine(e.readInt());
-      else if (tag == "Fingering") {
-            Fingering* f = new Fingering(score());
-            f->setTrack(track());
-            f->read(e);
-            add(f);
-            }
-      else if (tag == "Symbol") {
-            Symbol* s = new Symbol(score());
-            s->setTrack(track());
-            s->read(e);
-            add(s);
-            }
-      else if (tag == "Image") {
-            if (MScore::noImages)
-                  e.skipCurrentElement();
-            else {
-                  Image* image = new Image(score());
-                  image->setTrack(track());
-                  image->read(e);
-                  add(image);
+      switch (e.tag()) {
+            case XmlTag::PITCH:
+                  _pitch = e.readInt();
+                  break;
+            case XmlTag::TPC:
+                  _tpc[0] = e.readInt();
+                  _tpc[1] = _tpc[0];
+                  break;
+            case XmlTag::TRACK:           // for performance
+                  setTrack(e.readInt());
+                  break;
+            case XmlTag::ACCIDENTAL: {
+                  Accidental* a = new Accidental(score());
+                  a->setTrack(track());
+                  a->read(e);
+                  add(a);
                   }
-            }
-      else if (tag == "Bend") {
-            Bend* b = new Bend(score());
-            b->setTrack(track());
-            b->read(e);
-            add(b);
-            }
-      else if (tag == "NoteDot") {
-            NoteDot* dot = new NoteDot(score());
-            dot->read(e);
-            add(dot);
-            }
-      else if (tag == "Events") {
-            _playEvents.clear();    // remove default event
-            while (e.readNextStartElement()) {
-                  const QStringRef& t(e.name());
-                  if (t == "Event") {
-                        NoteEvent ne;
-                        ne.read(e);
-                        _playEvents.append(ne);
+                  break;
+            case XmlTag::SPANNER:
+                  Spanner::readSpanner(e, this, track());
+                  break;
+            case XmlTag::TPC2:
+                  _tpc[1] = e.readInt();
+                  break;
+            case XmlTag::SMALL:
+                  setSmall(e.readInt());
+                  break;
+            case XmlTag::MIRROR:
+                  readProperty(e, Pid::MIRROR_HEAD);
+                  break;
+            case XmlTag::DOT_POSITION:
+                  readProperty(e, Pid::DOT_POSITION);
+                  break;
+            case XmlTag::FIXED:
+                  setFixed(e.readBool());
+                  break;
+            case XmlTag::FIXED_LINE:
+                  setFixedLine(e.readInt());
+                  break;
+            case XmlTag::HEAD_SCHEME:
+                  readProperty(e, Pid::HEAD_SCHEME);
+                  break;
+            case XmlTag::HEAD:
+                  readProperty(e, Pid::HEAD_GROUP);
+                  break;
+            case XmlTag::VELOCITY:
+                  setVeloOffset(e.readInt());
+                  break;
+            case XmlTag::PLAY:
+                  setPlay(e.readInt());
+                  break;
+            case XmlTag::TUNING:
+                  setTuning(e.readDouble());
+                  break;
+            case XmlTag::FRET:
+                  setFret(e.readInt());
+                  break;
+            case XmlTag::STRING:
+                  setString(e.readInt());
+                  break;
+            case XmlTag::GHOST:
+                  setGhost(e.readInt());
+                  break;
+            case XmlTag::HEAD_TYPE:
+                  readProperty(e, Pid::HEAD_TYPE);
+                  break;
+            case XmlTag::VELO_TYPE:
+                  readProperty(e, Pid::VELO_TYPE);
+                  break;
+            case XmlTag::LINE:
+                  setLine(e.readInt());
+                  break;
+            case XmlTag::FINGERING: {
+                  Fingering* f = new Fingering(score());
+                  f->setTrack(track());
+                  f->read(e);
+                  add(f);
+                  }
+                  break;
+            case XmlTag::SYMBOL: {
+                  Symbol* s = new Symbol(score());
+                  s->setTrack(track());
+                  s->read(e);
+                  add(s);
+                  }
+                  break;
+            case XmlTag::IMAGE:
+                  if (MScore::noImages)
+                        e.skipCurrentElement();
+                  else {
+                        Image* image = new Image(score());
+                        image->setTrack(track());
+                        image->read(e);
+                        add(image);
                         }
-                  else
-                        e.unknown();
+                  break;
+            case XmlTag::BEND: {
+                  Bend* b = new Bend(score());
+                  b->setTrack(track());
+                  b->read(e);
+                  add(b);
                   }
-            if (chord())
-                  chord()->setPlayEventType(PlayEventType::User);
+                  break;
+            case XmlTag::NOTE_DOT: {
+                  NoteDot* dot = new NoteDot(score());
+                  dot->read(e);
+                  add(dot);
+                  }
+                  break;
+            case XmlTag::EVENTS:
+                  _playEvents.clear();    // remove default event
+                  while (e.readNextStartElement()) {
+                        const QStringRef& t(e.name());
+                        if (t == "Event") {
+                              NoteEvent ne;
+                              ne.read(e);
+                              _playEvents.append(ne);
+                              }
+                        else
+                              e.unknown();
+                        }
+                  if (chord())
+                        chord()->setPlayEventType(PlayEventType::User);
+                  break;
+            default:
+                  return Element::readProperties(e);
             }
-      else if (tag == "offset")
-            Element::readProperties(e);
-      else if (Element::readProperties(e))
-            ;
-      else
-            return false;
       return true;
       }
 
@@ -184,17 +184,12 @@ bool Score::read(XmlReader& e)
             else if (tag == "Score") {          // recursion
                   if (MScore::noExcerpts)
                         e.skipCurrentElement();
+                  else if (isMaster() && masterScore()->canDeferExcerpts())
+                        masterScore()->deferExcerpt(e);
                   else {
-                        e.tracks().clear();     // ???
                         MasterScore* m = masterScore();
-                        Score* s       = new Score(m, MScore::baseStyle());
                         Excerpt* ex    = new Excerpt(m);
-
-                        ex->setPartScore(s);
-                        e.setLastMeasure(nullptr);
-                        s->read(e);
-                        s->linkMeasures(m);
-                        ex->setTracks(e.tracks());
+                        m->readExcerpt(e, ex);
                         m->addExcerpt(ex);
                         }
                   }
@@ -356,6 +351,136 @@ void Score::linkMeasures(Score* score)
             }
       }
 
+//---------------------------------------------------------
+//   readExcerpt
+//    read the part score of ex from a nested <Score>
+//---------------------------------------------------------
+
+void MasterScore::readExcerpt(XmlReader& e, Excerpt* ex)
+      {
+      e.tracks().clear();     // ???
+      Score* s = new Score(this, MScore::baseStyle());
+
+      ex->setPartScore(s);
+      e.setLastMeasure(nullptr);
+      s->read(e);
+      s->linkMeasures(this);
+      ex->setTracks(e.tracks());
+      }
+
+//---------------------------------------------------------
+//   deferExcerpt
+//    add the excerpt of a nested <Score> by its name and
+//    its parts only, its part score is read by
+//    readDeferredExcerpt()
+//---------------------------------------------------------
+
+void MasterScore::deferExcerpt(XmlReader& e)
+      {
+      if (!_excerptsLinkContext)          // excerpts follow the staves of the master score
+            _excerptsLinkContext = new XmlLinkContext(e.linkContext());
+
+      Excerpt* ex = new Excerpt(this);
+      int nstaves = 1;        // the parts of the linked staves, as in initExcerpt()
+      while (e.readNextStartElement()) {
+            if (e.name() == "name")
+                  ex->setTitle(e.readElementText());
+            else if (e.name() == "Part") {
+                  while (e.readNextStartElement()) {
+                        if (e.name() != "Staff") {
+                              e.skipCurrentElement();
+                              continue;
+                              }
+                        Staff* linked = 0;
+                        while (e.readNextStartElement()) {
+                              if (e.name() == "linkedTo" && !linked)
+                                    linked = staff(e.readInt() - 1);
+                              else
+                                    e.skipCurrentElement();
+                              }
+                        if (linked && !(--nstaves)) {
+                              ex->parts().append(linked->part());
+                              nstaves = linked->part()->nstaves();
+                              }
+                        }
+                  }
+            else
+                  e.skipCurrentElement();
+            }
+      _unreadExcerpts.append(ex);
+      excerpts().append(ex);
+      }
+
+//---------------------------------------------------------
+//   readDeferredExcerpt
+//    read the part score of an excerpt added by
+//    deferExcerpt(), see MScore::deferExcerpts
+//    return false if ex was read already
+//---------------------------------------------------------
+
+bool MasterScore::readDeferredExcerpt(Excerpt* ex)
+      {
+      const int idx = ex ? _unreadExcerpts.indexOf(ex) : -1;
+      if (idx < 0)
+            return false;
+      _unreadExcerpts[idx] = 0;
+
+      XmlReader e(_excerptsData);
+      e.setDocName(fileInfo()->completeBaseName());
+      e.setLinkContext(*_excerptsLinkContext);
+
+      // museScore/Score/Score[idx]
+      bool found = false;
+      while (!found && e.readNextStartElement()) {
+            if (e.name() != "museScore") {
+                  e.skipCurrentElement();
+                  continue;
+                  }
+            while (!found && e.readNextStartElement()) {
+                  if (e.name() != "Score") {
+                        e.skipCurrentElement();
+                        continue;
+                        }
+                  int n = 0;
+                  while (e.readNextStartElement()) {
+                        if (e.name() == "Score" && n++ == idx) {
+                              found = true;
+                              break;
+                              }
+                        e.skipCurrentElement();
+                        }
+                  break;            // the first movement only
+                  }
+            }
+      if (!found) {
+            qDebug("readDeferredExcerpt: excerpt %d not found", idx);
+            return false;
+            }
+
+      readExcerpt(e, ex);
+      ex->parts().clear();          // found again from the part score
+      initExcerpt(ex);
+
+      if (_unreadExcerpts.count(0) == _unreadExcerpts.size()) {
+            // all excerpts are read, the file is not needed anymore
+            _unreadExcerpts.clear();
+            _excerptsData.clear();
+            delete _excerptsLinkContext;
+            _excerptsLinkContext = 0;
+            }
+      return true;
+      }
+
+//---------------------------------------------------------
+//   readDeferredExcerpts
+//---------------------------------------------------------
+
+void MasterScore::readDeferredExcerpts()
+      {
+      for (Excerpt* ex : excerpts())
+            readDeferredExcerpt(ex);
+      }
+
 //---------------------------------------------------------
 //   read
 //---------------------------------------------------------
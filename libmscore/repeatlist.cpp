@@ -104,8 +104,6 @@ void RepeatSegment::popMeasure()
 RepeatList::RepeatList(Score* s)
       {
       _score = s;
-      idx1  = 0;
-      idx2  = 0;
       }
 
 //---------------------------------------------------------
@@ -166,6 +164,87 @@ void RepeatList::updateTempo()
             utick        += s->len();
             t            += tl->tick2time(s->tick + s->len()) - ct;
             }
+      updateTickIndex();
+      _tempoTableSN = -1;
+      }
+
+//---------------------------------------------------------
+//   updateTickIndex
+//    map every tick to the first segment playing it,
+//    for tick2utick()
+//---------------------------------------------------------
+
+void RepeatList::updateTickIndex()
+      {
+      _tickBounds.clear();
+      _tickSegments.clear();
+      for (const RepeatSegment* s : *this) {
+            _tickBounds.push_back(s->tick);
+            _tickBounds.push_back(s->tick + s->len());
+            }
+      std::sort(_tickBounds.begin(), _tickBounds.end());
+      _tickBounds.erase(std::unique(_tickBounds.begin(), _tickBounds.end()), _tickBounds.end());
+      _tickSegments.assign(_tickBounds.size(), -1);
+
+      for (int i = 0; i < size(); ++i) {
+            const RepeatSegment* s = at(i);
+            auto b = std::lower_bound(_tickBounds.begin(), _tickBounds.end(), s->tick);
+            for (int k = int(b - _tickBounds.begin()); _tickBounds[k] < s->tick + s->len(); ++k) {
+                  if (_tickSegments[k] == -1)
+                        _tickSegments[k] = i;
+                  }
+            }
+      }
+
+//---------------------------------------------------------
+//   updateTempoTable
+//    collect the tempo changes of the unwound score, so
+//    utick2utime() does not need to search the TempoMap
+//---------------------------------------------------------
+
+void RepeatList::updateTempoTable() const
+      {
+      const TempoMap* tl = _score->tempomap();
+      _tempoTable.clear();
+      for (int i = 0; i < size(); ++i) {
+            const RepeatSegment* s = at(i);
+            const int tickOffset = s->utick - s->tick;
+            const bool lastSegment = (i + 1 == size());
+            const int endTick = s->tick + s->len();
+
+            // the tempo in effect at the start of the segment, as TempoMap::tick2time() finds it
+            TempoPoint p { s->utick, tickOffset, 0, 0.0, 2.0, s->timeOffset };
+            auto e = tl->upper_bound(s->tick);
+            if (e != tl->begin()) {
+                  auto pe = std::prev(e);
+                  p.tick  = pe->first;
+                  p.time  = pe->second.time;
+                  p.tempo = pe->second.tempo;
+                  }
+            _tempoTable.push_back(p);
+
+            // the last segment goes on beyond its end, see utick2utime()
+            for (; e != tl->end() && (lastSegment || e->first < endTick); ++e) {
+                  TempoPoint ep { e->first + tickOffset, tickOffset, e->first, e->second.time, e->second.tempo, s->timeOffset };
+                  _tempoTable.push_back(ep);
+                  }
+            }
+      _tempoTableMap = tl;
+      _tempoTableSN  = tl->tempoSN();
+      }
+
+//---------------------------------------------------------
+//   segmentIndexFromUTick
+//    return the index of the last segment starting at or
+//    before utick, -1 if there is none
+//---------------------------------------------------------
+
+int RepeatList::segmentIndexFromUTick(int utick) const
+      {
+      auto i = std::upper_bound(cbegin(), cend(), utick, [](int utick, RepeatSegment const * rs) {
+            return utick < rs->utick;
+            });
+      return int(i - cbegin()) - 1;
       }
 
 //---------------------------------------------------------
@@ -174,18 +253,13 @@ void RepeatList::updateTempo()
 
 int RepeatList::utick2tick(int tick) const
       {
-      unsigned n = size();
-      if (n == 0)
+      if (empty())
             return tick;
       if (tick < 0)
             return 0;
-      unsigned ii = (idx1 < n) && (tick >= at(idx1)->utick) ? idx1 : 0;
-      for (unsigned i = ii; i < n; ++i) {
-            if ((tick >= at(i)->utick) && ((i + 1 == n) || (tick < at(i+1)->utick))) {
-                  idx1 = i;
-                  return tick - (at(i)->utick - at(i)->tick);
-                  }
-            }
+      int i = segmentIndexFromUTick(tick);
+      if (i >= 0)
+            return tick - (at(i)->utick - at(i)->tick);
       if (MScore::debugMode) {
             qFatal("tick %d not found in RepeatList", tick);
             }
@@ -200,9 +274,11 @@ int RepeatList::tick2utick(int tick) const
       {
       if (empty())
             return 0;
-      for (const RepeatSegment* s : *this) {
-            if (tick >= s->tick && tick < (s->tick + s->len() ))
-                  return s->utick + (tick - s->tick);
+      auto b = std::upper_bound(_tickBounds.begin(), _tickBounds.end(), tick);
+      if (b != _tickBounds.begin()) {
+            int k = _tickSegments[b - _tickBounds.begin() - 1];
+            if (k >= 0)
+                  return at(k)->utick + (tick - at(k)->tick);
             }
       return last()->utick + (tick - last()->tick);
       }
@@ -213,16 +289,21 @@ int RepeatList::tick2utick(int tick) const
 
 qreal RepeatList::utick2utime(int tick) const
       {
-      unsigned n = size();
-      unsigned ii = (idx1 < n) && (tick >= at(idx1)->utick) ? idx1 : 0;
-      for (unsigned i = ii; i < n; ++i) {
-            if ((tick >= at(i)->utick) && ((i + 1 == n) || (tick < at(i+1)->utick))) {
-                  int t     = tick - (at(i)->utick - at(i)->tick);
-                  qreal tt = _score->tempomap()->tick2time(t) + at(i)->timeOffset;
-                  return tt;
-                  }
-            }
-      return 0.0;
+      if (empty())
+            return 0.0;
+      const TempoMap* tl = _score->tempomap();
+      if (_tempoTableMap != tl || _tempoTableSN != tl->tempoSN())
+            updateTempoTable();
+      auto i = std::upper_bound(_tempoTable.cbegin(), _tempoTable.cend(), tick, [](int tick, const TempoPoint& p) {
+            return tick < p.utick;
+            });
+      if (i == _tempoTable.cbegin())
+            return 0.0;
+      const TempoPoint& p = *std::prev(i);
+      // the same arithmetic as TempoMap::tick2time()
+      qreal delta = qreal(tick - p.tickOffset - p.tick);
+      qreal time  = p.time + delta / (MScore::division * p.tempo * tl->relTempo());
+      return time + p.timeOffset;
       }
 
 //---------------------------------------------------------
@@ -231,13 +312,12 @@ qreal RepeatList::utick2utime(int tick) const
 
 int RepeatList::utime2utick(qreal t) const
       {
-      unsigned n = size();
-      unsigned ii = (idx2 < n) && (t >= at(idx2)->utime) ? idx2 : 0;
-      for (unsigned i = ii; i < n; ++i) {
-            if ((t >= at(i)->utime) && ((i + 1 == n) || (t < at(i+1)->utime))) {
-                  idx2 = i;
-                  return _score->tempomap()->time2tick(t - at(i)->timeOffset) + (at(i)->utick - at(i)->tick);
-                  }
+      auto ii = std::upper_bound(cbegin(), cend(), t, [](qreal t, RepeatSegment const * rs) {
+            return t < rs->utime;
+            });
+      if (ii != cbegin()) {
+            const RepeatSegment* rs = *std::prev(ii);
+            return _score->tempomap()->time2tick(t - rs->timeOffset) + (rs->utick - rs->tick);
             }
       if (MScore::debugMode) {
             qFatal("time %f not found in RepeatList", t);
@@ -278,6 +358,8 @@ void RepeatList::flatten()
       while (m);
       push_back(s);
 
+      updateTickIndex();
+      _tempoTableSN = -1;
       _expanded = false;
       }
 
@@ -20,6 +20,7 @@ class Measure;
 class Volta;
 class Jump;
 class RepeatListElement;
+class TempoMap;
 
 //---------------------------------------------------------
 //   RepeatSegment
@@ -57,8 +58,28 @@ class RepeatSegment {
 
 class RepeatList: public QList<RepeatSegment*>
       {
+      //---------------------------------------------------
+      //   TempoPoint
+      //    a stretch of constant tempo in the unwound score
+      //---------------------------------------------------
+
+      struct TempoPoint {
+            int utick;              // where the stretch starts
+            int tickOffset;         // utick - tick in its RepeatSegment
+            int tick;               // of the tempo event in effect
+            qreal time;             // of that tempo event
+            qreal tempo;
+            qreal timeOffset;       // of its RepeatSegment
+            };
+
       Score* _score;
-      mutable unsigned idx1, idx2;   // cached values
+
+      std::vector<int> _tickBounds;       // start and end ticks of all segments, sorted
+      std::vector<int> _tickSegments;     // first segment playing _tickBounds[i] to _tickBounds[i+1], -1 if none
+
+      mutable std::vector<TempoPoint> _tempoTable;     // sorted by utick, see utick2utime()
+      mutable const TempoMap* _tempoTableMap = nullptr;
+      mutable int _tempoTableSN = -1;     // TempoMap::tempoSN() the table was built for
 
       bool _expanded = false;
       bool _scoreChanged = true;
@@ -74,6 +95,9 @@ class RepeatList: public QList<RepeatSegment*>
                        Volta const * * const activeVolta, RepeatListElement const * * const startRepeatReference) const;
       void unwind();
       void flatten();
+      void updateTickIndex();
+      void updateTempoTable() const;
+      int segmentIndexFromUTick(int utick) const;
 
    public:
       RepeatList(Score* s);
@@ -989,32 +989,35 @@ void Rest::write(XmlWriter& xml) const
 void Rest::read(XmlReader& e)
       {
       while (e.readNextStartElement()) {
-            const QStringRef& tag(e.name());
-            if (tag == "Symbol") {
-                  Symbol* s = new Symbol(score());
-                  s->setTrack(track());
-                  s->read(e);
-                  add(s);
-                  }
-            else if (tag == "Image") {
-                  if (MScore::noImages)
-                        e.skipCurrentElement();
-                  else {
-                        Image* image = new Image(score());
-                        image->setTrack(track());
-                        image->read(e);
-                        add(image);
+            switch (e.tag()) {
+                  case XmlTag::SYMBOL: {
+                        Symbol* s = new Symbol(score());
+                        s->setTrack(track());
+                        s->read(e);
+                        add(s);
                         }
+                        break;
+                  case XmlTag::IMAGE:
+                        if (MScore::noImages)
+                              e.skipCurrentElement();
+                        else {
+                              Image* image = new Image(score());
+                              image->setTrack(track());
+                              image->read(e);
+                              add(image);
+                              }
+                        break;
+                  case XmlTag::NOTE_DOT: {
+                        NoteDot* dot = new NoteDot(score());
+                        dot->read(e);
+                        add(dot);
+                        }
+                        break;
+                  default:
+                        if (!ChordRest::readProperties(e))
+                              e.unknown();
+                        break;
                   }
-            else if (tag == "NoteDot") {
-                  NoteDot* dot = new NoteDot(score());
-                  dot->read(e);
-                  add(dot);
-                  }
-            else if (ChordRest::readProperties(e))
-                  ;
-            else
-                  e.unknown();
             }
       }
 
@@ -60,6 +60,8 @@
 #include "tie.h"
 #include "tiemap.h"
 #include "layoutbreak.h"
+#include "layout.h"
+#include "layoutprofile.h"
 #include "harmony.h"
 #include "mscore.h"
 #include "scoreOrder.h"
@@ -91,9 +93,10 @@ bool midiOutputTrace = false;
 
 MeasureBaseList::MeasureBaseList()
       {
-      _first = 0;
-      _last  = 0;
-      _size  = 0;
+      _first      = 0;
+      _last       = 0;
+      _size       = 0;
+      _generation = 0;
       };
 
 //---------------------------------------------------------
@@ -102,6 +105,7 @@ MeasureBaseList::MeasureBaseList()
 
 void MeasureBaseList::push_back(MeasureBase* e)
       {
+      ++_generation;
       ++_size;
       if (_last) {
             _last->setNext(e);
@@ -122,6 +126,7 @@ void MeasureBaseList::push_back(MeasureBase* e)
 
 void MeasureBaseList::push_front(MeasureBase* e)
       {
+      ++_generation;
       ++_size;
       if (_first) {
             _first->setPrev(e);
@@ -153,6 +158,7 @@ void MeasureBaseList::add(MeasureBase* e)
             return;
             }
       ++_size;
+      ++_generation;
       e->setPrev(el->prev());
       el->prev()->setNext(e);
       el->setPrev(e);
@@ -164,6 +170,7 @@ void MeasureBaseList::add(MeasureBase* e)
 
 void MeasureBaseList::remove(MeasureBase* el)
       {
+      ++_generation;
       --_size;
       if (el->prev())
             el->prev()->setNext(el->next());
@@ -181,6 +188,7 @@ void MeasureBaseList::remove(MeasureBase* el)
 
 void MeasureBaseList::insert(MeasureBase* fm, MeasureBase* lm)
       {
+      ++_generation;
       ++_size;
       for (MeasureBase* m = fm; m != lm; m = m->next())
             ++_size;
@@ -202,6 +210,7 @@ void MeasureBaseList::insert(MeasureBase* fm, MeasureBase* lm)
 
 void MeasureBaseList::remove(MeasureBase* fm, MeasureBase* lm)
       {
+      ++_generation;
       --_size;
       for (MeasureBase* m = fm; m != lm; m = m->next())
             --_size;
@@ -223,6 +232,7 @@ void MeasureBaseList::remove(MeasureBase* fm, MeasureBase* lm)
 
 void MeasureBaseList::change(MeasureBase* ob, MeasureBase* nb)
       {
+      ++_generation;
       nb->setPrev(ob->prev());
       nb->setNext(ob->next());
       if (ob->prev())
@@ -320,6 +330,8 @@ Score::~Score()
       {
       Score::validScores.erase(this);
 
+      discardPendingLayout();       // its systems are deleted with _systems below
+      delete _layoutProfile;
       foreach(MuseScoreView* v, viewer)
             v->removeScore();
       // deselectAll();
@@ -1940,6 +1952,19 @@ void Score::setMetaTag(const QString& tag, const QString& val)
 //---------------------------------------------------------
 
 void MasterScore::addExcerpt(Excerpt* ex)
+      {
+      initExcerpt(ex);
+      excerpts().append(ex);
+      setExcerptsChanged(true);
+      }
+
+//---------------------------------------------------------
+//   initExcerpt
+//    set the parts and tracks of ex from the staff
+//    links of its part score
+//---------------------------------------------------------
+
+void MasterScore::initExcerpt(Excerpt* ex)
       {
       Score* score = ex->partScore();
 
@@ -1980,8 +2005,6 @@ void MasterScore::addExcerpt(Excerpt* ex)
                   }
             ex->setTracks(tracks);
             }
-      excerpts().append(ex);
-      setExcerptsChanged(true);
       }
 
 //---------------------------------------------------------
@@ -1991,6 +2014,9 @@ void MasterScore::addExcerpt(Excerpt* ex)
 void MasterScore::removeExcerpt(Excerpt* ex)
       {
       if (excerpts().removeOne(ex)) {
+            const int idx = _unreadExcerpts.indexOf(ex);
+            if (idx >= 0)
+                  _unreadExcerpts[idx] = 0;
             setExcerptsChanged(true);
             // delete ex;
             }
@@ -3104,10 +3130,35 @@ void Score::switchToPageMode()
       {
             if (_layoutMode != LayoutMode::PAGE) {
                   setLayoutMode(LayoutMode::PAGE);
-                  doLayout();
+                  if (!layoutValid(LayoutMode::PAGE))
+                        doLayout();
             }
       }
 
+//---------------------------------------------------------
+//   setLayoutMode
+//---------------------------------------------------------
+
+void Score::setLayoutMode(LayoutMode lm)
+      {
+      if (lm != _layoutMode)
+            continueLayout();       // a pending layout is completed in the mode it was started in
+      _layoutMode = lm;
+      }
+
+//---------------------------------------------------------
+//   layoutProfile
+//    the times of the layout phases collected so far,
+//    created on first use
+//---------------------------------------------------------
+
+LayoutProfile* Score::layoutProfile()
+      {
+      if (!_layoutProfile)
+            _layoutProfile = new LayoutProfile;
+      return _layoutProfile;
+      }
+
 //---------------------------------------------------------
 //   selectAdd
 //---------------------------------------------------------
@@ -4913,6 +4964,7 @@ MasterScore::~MasterScore()
       delete _sigmap;
       delete _tempomap;
       qDeleteAll(_excerpts);
+      delete _excerptsLinkContext;
       }
 
 //---------------------------------------------------------
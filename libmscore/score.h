@@ -89,11 +89,13 @@ class UndoCommand;
 class UndoStack;
 class Volta;
 class XmlWriter;
+struct XmlLinkContext;
 class Channel;
 class ScoreOrder;
 struct Interval;
 struct TEvent;
 struct LayoutContext;
+class LayoutProfile;
 
 enum class Tid;
 enum class ClefType : signed char;
@@ -149,6 +151,7 @@ class MeasureBaseList {
       int _size;
       MeasureBase* _first;
       MeasureBase* _last;
+      int _generation;        // incremented on every change of the list, see MeasureIndex
 
       void push_back(MeasureBase* e);
       void push_front(MeasureBase* e);
@@ -157,13 +160,34 @@ class MeasureBaseList {
       MeasureBaseList();
       MeasureBase* first() const { return _first; }
       MeasureBase* last()  const { return _last; }
-      void clear()               { _first = _last = 0; _size = 0; }
+      void clear()               { _first = _last = 0; _size = 0; ++_generation; }
       void add(MeasureBase*);
       void remove(MeasureBase*);
       void insert(MeasureBase*, MeasureBase*);
       void remove(MeasureBase*, MeasureBase*);
       void change(MeasureBase* o, MeasureBase* n);
       int size() const { return _size; }
+      int generation() const     { return _generation; }
+      void changed()             { ++_generation; }     // measures were linked in another way
+      };
+
+//---------------------------------------------------------
+//   MeasureIndex
+//    the measures of a score in tick order, for the
+//    binary search of Score::tick2measure()
+//---------------------------------------------------------
+
+class MeasureIndex {
+      QVector<Measure*> _measures;
+      int _generation { -1 };       // of the MeasureBaseList the index was built from
+      bool _mmRests   { false };    // built along nextMeasureMM()
+
+      void build(Measure* first, int generation, bool mmRests);
+      int search(const Fraction& tick) const;
+      bool linked(int idx, Measure* first) const;
+
+   public:
+      Measure* find(const Fraction& tick, Measure* first, int generation, bool mmRests);
       };
 
 //---------------------------------------------------------
@@ -439,6 +463,8 @@ class Score : public QObject, public ScoreElement {
       UpdateState _updateState;
 
       MeasureBaseList _measures;          // here are the notes
+      mutable MeasureIndex _measureIndex;       // see tick2measure()
+      mutable MeasureIndex _measureIndexMM;     // see tick2measureMM()
       QList<Part*> _parts;
       QList<Staff*> _staves;
 
@@ -450,6 +476,10 @@ class Score : public QObject, public ScoreElement {
       //
       QList<Page*> _pages;          // pages are build from systems
       QList<System*> _systems;      // measures are accumulated to systems
+      LayoutContext* _pendingLayout { 0 };      // the rest of a layout started by doLayoutPages()
+      LayoutProfile* _layoutProfile { 0 };      // see MScore::profileLayout
+      QByteArray _layoutCache;                  // layout results saved with the score, see setLayoutCache()
+      QByteArray _layoutCacheKey;               // layoutCacheKey() of the content _layoutCache was made for
 
       InputState _is;
       MStyle _style;
@@ -561,6 +591,8 @@ class Score : public QObject, public ScoreElement {
    protected:
       int _fileDivision; ///< division of current loading *.msc file
       LayoutMode _layoutMode { LayoutMode::PAGE };
+      LayoutMode _validLayoutMode { LayoutMode::PAGE };     // the mode of the last complete layout
+      bool _layoutValid { false };                          // pages and systems hold a layout in _validLayoutMode
       SynthesizerState _synthesizerState;
 
       void createPlayEvents(Chord*);
@@ -1061,6 +1093,17 @@ class Score : public QObject, public ScoreElement {
 
       void doLayout();
       void doLayoutRange(const Fraction&, const Fraction&);
+      bool startLayoutRange(LayoutContext& lc, const Fraction&, const Fraction&);
+      void doLayoutPages(int n);
+      void continueLayout(int n = -1);
+      void discardPendingLayout();
+      bool layoutPending() const                 { return _pendingLayout; }
+      LayoutProfile* layoutProfile();
+      bool hasLayoutProfile() const              { return _layoutProfile; }
+      const QByteArray& layoutCache() const      { return _layoutCache; }
+      void setLayoutCache(const QByteArray& data);
+      void setLayoutCache(const QByteArray& data, const QByteArray& key) { _layoutCache = data; _layoutCacheKey = key; }
+      QByteArray layoutCacheKey(const QByteArray& scoreData) const;
       void layoutLinear(bool layoutAll, LayoutContext& lc);
 
       void layoutChords1(Segment* segment, int staffIdx);
@@ -1111,7 +1154,9 @@ class Score : public QObject, public ScoreElement {
       const QList<MuseScoreView*>& getViewer() const { return viewer;       }
 
       LayoutMode layoutMode() const         { return _layoutMode; }
-      void setLayoutMode(LayoutMode lm)     { _layoutMode = lm;   }
+      void setLayoutMode(LayoutMode lm);
+      bool layoutValid(LayoutMode lm) const { return _layoutValid && _validLayoutMode == lm && !cmdState().layoutRange(); }
+      void invalidateLayout()               { _layoutValid = false; }
 
       bool floatMode() const                { return layoutMode() == LayoutMode::FLOAT; }
       bool pageMode() const                 { return layoutMode() == LayoutMode::PAGE; }
@@ -1279,6 +1324,9 @@ class MasterScore : public Score {
       bool _expandRepeats     { MScore::playRepeats };
       bool _playlistDirty     { true };
       QList<Excerpt*> _excerpts;
+      QList<Excerpt*> _unreadExcerpts;              ///< excerpts not read yet, in file order; 0 once read
+      QByteArray _excerptsData;                     ///< the file the unread excerpts are read from
+      XmlLinkContext* _excerptsLinkContext { 0 };
       std::vector<PartChannelSettingsLink> _playbackSettingsLinks;
       Score* _playbackScore = nullptr;
       Revisions* _revisions;
@@ -1374,7 +1422,7 @@ class MasterScore : public Score {
       void setTempomap(TempoMap* tm);
 
       bool saveFile(bool generateBackup = true);
-      FileError read1(XmlReader&, bool ignoreVersionError);
+      FileError read1(XmlReader&, bool ignoreVersionError, const QByteArray& data = QByteArray());
       FileError loadCompressedMsc(QIODevice*, bool ignoreVersionError);
       FileError loadMsc(QString name, bool ignoreVersionError);
       FileError loadMsc(QString name, QIODevice*, bool ignoreVersionError);
@@ -1383,7 +1431,7 @@ class MasterScore : public Score {
       FileError read302(XmlReader&);
       QByteArray readToBuffer();
       QByteArray readCompressedToBuffer();
-      int readStyleDefaultsVersion();
+      int readStyleDefaultsVersion(const QByteArray& data);
       int styleDefaultByMscVersion(const int mscVer) const;
 
       Omr* omr() const                         { return _omr;     }
@@ -1419,8 +1467,15 @@ class MasterScore : public Score {
       void setPos(POS pos, Fraction tick);
 
       void addExcerpt(Excerpt*);
+      void initExcerpt(Excerpt*);
       void removeExcerpt(Excerpt*);
       void deleteExcerpt(Excerpt*);
+      void readExcerpt(XmlReader&, Excerpt*);
+      void deferExcerpt(XmlReader&);
+      bool canDeferExcerpts() const                  { return !_excerptsData.isEmpty(); }
+      bool isExcerptRead(Excerpt* ex) const          { return !_unreadExcerpts.contains(ex); }
+      bool readDeferredExcerpt(Excerpt*);
+      void readDeferredExcerpts();
 
       void setPlaybackScore(Score*);
       Score* playbackScore() { return _playbackScore; }
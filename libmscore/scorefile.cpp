@@ -276,6 +276,8 @@ void Score::write(XmlWriter& xml, bool selectionOnly)
             while (score->prev())
                   score = score->prev();
             while (score) {
+                  if (!selectionOnly)
+                        score->readDeferredExcerpts();      // excerpts are written from their part scores
                   score->writeMovement(xml, selectionOnly);
                   score = score->next();
                   }
@@ -551,7 +553,8 @@ QImage Score::createThumbnail()
       {
       LayoutMode mode = layoutMode();
       setLayoutMode(LayoutMode::PAGE);
-      doLayout();
+      if (!layoutValid(LayoutMode::PAGE))
+            doLayout();
 
       Page* page = pages().at(0);
       QRectF fr  = page->abbox();
@@ -674,6 +677,14 @@ bool Score::saveCompressedFile(QIODevice* f, const QString& fn, bool onlySelecti
       if (_audio)
             uz.addFile("audio.ogg", _audio->data());
 
+      //
+      // save the layout cache if it was made for this content
+      //
+      if (!_layoutCache.isEmpty() && !onlySelection && layoutCacheKey(dbuf.data()) == _layoutCacheKey) {
+            uz.addFile("LayoutCache/key", _layoutCacheKey);
+            uz.addFile("LayoutCache/layout.json", _layoutCache);
+            }
+
       uz.close();
       return true;
       }
@@ -782,6 +793,41 @@ bool Score::saveFile(QIODevice* f, bool msczFormat, bool onlySelection)
       return true;
       }
 
+//---------------------------------------------------------
+//   layoutCacheKey
+//    identifies the layout of scoreData (as written by
+//    saveFile()), which depends on the score and its style,
+//    the version of libmscore and the fonts found for the style
+//---------------------------------------------------------
+
+QByteArray Score::layoutCacheKey(const QByteArray& scoreData) const
+      {
+      QCryptographicHash h(QCryptographicHash::Sha1);
+      h.addData(QByteArray(VERSION " " MSC_VERSION " "));
+      h.addData(revision.toUtf8());
+      h.addData(scoreData);
+      for (int i = 0; i < int(Sid::STYLES); ++i) {
+            const Sid sid = Sid(i);
+            if (QByteArray(MStyle::valueName(sid)).endsWith("FontFace"))
+                  h.addData(QFontInfo(QFont(styleSt(sid))).family().toUtf8());
+            }
+      return h.result().toHex();
+      }
+
+//---------------------------------------------------------
+//   setLayoutCache
+//    set layout results made for the current content,
+//    saveCompressedFile() saves them with the score
+//---------------------------------------------------------
+
+void Score::setLayoutCache(const QByteArray& data)
+      {
+      QBuffer dbuf;
+      dbuf.open(QIODevice::ReadWrite);
+      saveFile(&dbuf, true, false);
+      setLayoutCache(data, layoutCacheKey(dbuf.data()));
+      }
+
 //---------------------------------------------------------
 //   readRootFile
 //---------------------------------------------------------
@@ -842,12 +888,12 @@ Score::FileError MasterScore::loadCompressedMsc(QIODevice* io, bool ignoreVersio
             return FileError::FILE_NO_ROOTFILE;
 
       //
-      // load images
+      // load images, they are only inflated once they are drawn or saved
       //
       if (!MScore::noImages) {
             foreach(const QString& s, sl) {
-                  QByteArray dbuf = uz.fileData(s);
-                  imageStore.add(s, dbuf);
+                  MQZipReader::StoredData packed = uz.storedFileData(s);
+                  imageStore.addDeferred(s, [packed]() { return MQZipReader::uncompress(packed); });
                   }
             }
 
@@ -865,7 +911,7 @@ Score::FileError MasterScore::loadCompressedMsc(QIODevice* io, bool ignoreVersio
       XmlReader e(dbuf);
       e.setDocName(masterScore()->fileInfo()->completeBaseName());
 
-      FileError retval = read1(e, ignoreVersionError);
+      FileError retval = read1(e, ignoreVersionError, dbuf);
 
 #ifdef OMR
       //
@@ -893,6 +939,17 @@ Score::FileError MasterScore::loadCompressedMsc(QIODevice* io, bool ignoreVersio
             QByteArray dbuf1 = uz.fileData("audio.ogg");
             audio()->setData(dbuf1);
             }
+      //
+      //  read the layout cache, it is dropped if the score, libmscore
+      //  or the fonts changed since it was saved
+      //
+      QByteArray key = uz.fileData("LayoutCache/key");
+      if (retval == FileError::FILE_NO_ERROR && !key.isEmpty()) {
+            if (key == layoutCacheKey(dbuf))
+                  setLayoutCache(uz.fileData("LayoutCache/layout.json"), key);
+            else
+                  qDebug("layout cache out of date");
+            }
       return retval;
       }
 
@@ -914,18 +971,26 @@ int MasterScore::styleDefaultByMscVersion(const int mscVer) const
       return MSCVERSION;
       }
 
-int MasterScore::readStyleDefaultsVersion()
+//---------------------------------------------------------
+//   readStyleDefaultsVersion
+//    find the first <defaultsVersion> in the score data
+//    that is being read. A byte search is sufficient:
+//    '<' is always escaped in element text, so the tag
+//    can only occur as an element.
+//---------------------------------------------------------
+
+int MasterScore::readStyleDefaultsVersion(const QByteArray& data)
       {
       if (styleB(Sid::usePre_3_6_defaults))
             return style().defaultStyleVersion();
 
-      XmlReader e(readToBuffer());
-      e.setDocName(masterScore()->fileInfo()->completeBaseName());
-
-      while (!e.atEnd()) {
-            e.readNext();
-            if (e.name() == "defaultsVersion")
-                  return e.readInt();
+      static const QByteArray tag("<defaultsVersion>");
+      int pos = data.indexOf(tag);
+      if (pos != -1) {
+            pos += tag.size();
+            int end = data.indexOf('<', pos);
+            if (end != -1)
+                  return data.mid(pos, end - pos).trimmed().toInt();
             }
 
       return styleDefaultByMscVersion(mscVersion());
@@ -954,8 +1019,9 @@ Score::FileError MasterScore::loadMsc(QString name, QIODevice* io, bool ignoreVe
       if (name.endsWith(".mscz") || name.endsWith(".mscz,"))
             return loadCompressedMsc(io, ignoreVersionError);
       else {
-            XmlReader r(io);
-            return read1(r, ignoreVersionError);
+            QByteArray data = io->readAll();
+            XmlReader r(data);
+            return read1(r, ignoreVersionError, data);
             }
       }
 
@@ -1013,10 +1079,11 @@ void MasterScore::parseVersion(const QString& val)
 
 //---------------------------------------------------------
 //   read1
+//    data is the document e reads from, if available
 //    return true on success
 //---------------------------------------------------------
 
-Score::FileError MasterScore::read1(XmlReader& e, bool ignoreVersionError)
+Score::FileError MasterScore::read1(XmlReader& e, bool ignoreVersionError, const QByteArray& data)
       {
       while (e.readNextStartElement()) {
             if (e.name() == "museScore") {
@@ -1033,7 +1100,7 @@ Score::FileError MasterScore::read1(XmlReader& e, bool ignoreVersionError)
                               return FileError::FILE_OLD_300_FORMAT;
                         }
 
-                  int defaultsVersion = readStyleDefaultsVersion();
+                  int defaultsVersion = readStyleDefaultsVersion(data);
 
                   setStyle(*MStyle::resolveStyleDefaults(defaultsVersion));
                   style().setDefaultStyleVersion(defaultsVersion);
@@ -1043,8 +1110,15 @@ Score::FileError MasterScore::read1(XmlReader& e, bool ignoreVersionError)
                         error = read114(e);
                   else if (mscVersion() <= 207)
                         error = read206(e);
-                  else
+                  else {
+                        // keep a copy of the file to read the excerpts from when they are asked for,
+                        // data may point into a buffer the caller frees after loading
+                        if (MScore::deferExcerpts && !data.isEmpty())
+                              _excerptsData = QByteArray(data.constData(), data.size());
                         error = read302(e);
+                        if (_unreadExcerpts.isEmpty())
+                              _excerptsData.clear();
+                        }
                   setExcerptsChanged(false);
                   return error;
                   }
@@ -1097,8 +1171,8 @@ QByteArray MasterScore::readCompressedToBuffer()
       // load images
       //
       foreach(const QString& s, images) {
-            QByteArray dbuf = uz.fileData(s);
-            imageStore.add(s, dbuf);
+            MQZipReader::StoredData packed = uz.storedFileData(s);
+            imageStore.addDeferred(s, [packed]() { return MQZipReader::uncompress(packed); });
             }
 
       if (rootfile.isEmpty()) {
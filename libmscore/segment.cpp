@@ -868,16 +868,20 @@ void Segment::write(XmlWriter& xml) const
 void Segment::read(XmlReader& e)
       {
       while (e.readNextStartElement()) {
-            const QStringRef& tag(e.name());
-
-            if (tag == "subtype")
-                  e.skipCurrentElement();
-            else if (tag == "leadingSpace")
-                  _extraLeadingSpace = Spatium(e.readDouble());
-            else if (tag == "trailingSpace")          // obsolete
-                  e.readDouble();
-            else
-                  e.unknown();
+            switch (e.tag()) {
+                  case XmlTag::SUBTYPE:
+                        e.skipCurrentElement();
+                        break;
+                  case XmlTag::LEADING_SPACE:
+                        _extraLeadingSpace = Spatium(e.readDouble());
+                        break;
+                  case XmlTag::TRAILING_SPACE:        // obsolete
+                        e.readDouble();
+                        break;
+                  default:
+                        e.unknown();
+                        break;
+                  }
             }
       }
 
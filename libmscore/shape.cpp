@@ -72,6 +72,126 @@ Shape Shape::translated(const QPointF& pt) const
       return s;
       }
 
+//-------------------------------------------------------------------
+//   HSpan
+//    the extent of a rectangle, kept in a plain array for
+//    the sweep in sweepHorizontalDistance()
+//-------------------------------------------------------------------
+
+struct HSpan {
+      qreal top;
+      qreal bottom;
+      qreal left;
+      qreal right;
+      };
+
+//-------------------------------------------------------------------
+//   sweepHorizontalDistance
+//    minHorizontalDistance() for shapes with many rectangles.
+//    Rectangles are sorted by top and merged with a sweep
+//    line, a rectangle is only compared with the rectangles
+//    of the other shape it overlaps vertically. The result
+//    is the same as comparing every pair.
+//-------------------------------------------------------------------
+
+static qreal sweepHorizontalDistance(const Shape& s1, const Shape& s2)
+      {
+      qreal dist = -1000000.0;      // min real
+
+      // zero width rectangles collide with every rectangle of the other shape
+      qreal maxRight = -std::numeric_limits<qreal>::max();
+      qreal minLeft  = std::numeric_limits<qreal>::max();
+      for (const QRectF& r1 : s1)
+            maxRight = qMax(maxRight, r1.right());
+      for (const QRectF& r2 : s2)
+            minLeft = qMin(minLeft, r2.left());
+
+      std::vector<HSpan> a1, a2;          // positive height
+      std::vector<HSpan> flat1, flat2;    // zero height, collide at the same y only
+      std::vector<HSpan> odd1, odd2;      // negative height, compared with every rectangle
+      auto classify = [](const QRectF& r, std::vector<HSpan>& a, std::vector<HSpan>& flat, std::vector<HSpan>& odd) {
+            HSpan h { r.top(), r.bottom(), r.left(), r.right() };
+            if (r.height() > 0.0)
+                  a.push_back(h);
+            else if (r.height() == 0.0)
+                  flat.push_back(h);
+            else
+                  odd.push_back(h);
+            };
+      for (const QRectF& r1 : s1) {
+            if (r1.width() == 0.0)
+                  dist = qMax(dist, r1.right() - minLeft);
+            else
+                  classify(r1, a1, flat1, odd1);
+            }
+      for (const QRectF& r2 : s2) {
+            if (r2.width() == 0.0)
+                  dist = qMax(dist, maxRight - r2.left());
+            else
+                  classify(r2, a2, flat2, odd2);
+            }
+
+      // negative heights
+      for (const HSpan& h1 : odd1) {
+            for (const std::vector<HSpan>* v : { &a2, &odd2 }) {
+                  for (const HSpan& h2 : *v) {
+                        if (Ms::intersects(h1.top, h1.bottom, h2.top, h2.bottom))
+                              dist = qMax(dist, h1.right - h2.left);
+                        }
+                  }
+            }
+      for (const HSpan& h2 : odd2) {
+            for (const HSpan& h1 : a1) {
+                  if (Ms::intersects(h1.top, h1.bottom, h2.top, h2.bottom))
+                        dist = qMax(dist, h1.right - h2.left);
+                  }
+            }
+
+      auto byTop = [](const HSpan& a, const HSpan& b) { return a.top < b.top; };
+
+      // zero heights at the same y
+      std::sort(flat1.begin(), flat1.end(), byTop);
+      std::sort(flat2.begin(), flat2.end(), byTop);
+      for (size_t i = 0, j = 0; i < flat1.size() && j < flat2.size();) {
+            const qreal y = flat1[i].top;
+            if (y < flat2[j].top) {
+                  ++i;
+                  continue;
+                  }
+            if (flat2[j].top < y) {
+                  ++j;
+                  continue;
+                  }
+            qreal right = -std::numeric_limits<qreal>::max();
+            for (; i < flat1.size() && flat1[i].top == y; ++i)
+                  right = qMax(right, flat1[i].right);
+            for (; j < flat2.size() && flat2[j].top == y; ++j)
+                  dist = qMax(dist, right - flat2[j].left);
+            }
+
+      // positive heights: sweep down, keeping the rectangles that reach below the sweep line
+      std::sort(a1.begin(), a1.end(), byTop);
+      std::sort(a2.begin(), a2.end(), byTop);
+      std::vector<HSpan> active1, active2;
+      for (size_t i = 0, j = 0; i < a1.size() || j < a2.size();) {
+            if (j == a2.size() || (i < a1.size() && a1[i].top <= a2[j].top)) {
+                  const HSpan& h1 = a1[i++];
+                  active2.erase(std::remove_if(active2.begin(), active2.end(), [&h1](const HSpan& h) { return h.bottom <= h1.top; }), active2.end());
+                  for (const HSpan& h2 : active2)
+                        dist = qMax(dist, h1.right - h2.left);
+                  active1.push_back(h1);
+                  }
+            else {
+                  const HSpan& h2 = a2[j++];
+                  active1.erase(std::remove_if(active1.begin(), active1.end(), [&h2](const HSpan& h) { return h.bottom <= h2.top; }), active1.end());
+                  for (const HSpan& h1 : active1)
+                        dist = qMax(dist, h1.right - h2.left);
+                  active2.push_back(h2);
+                  }
+            }
+      return dist;
+      }
+
 //-------------------------------------------------------------------
 //   minHorizontalDistance
 //    a is located right of this shape.
@@ -81,6 +201,9 @@ Shape Shape::translated(const QPointF& pt) const
 
 qreal Shape::minHorizontalDistance(const Shape& a) const
       {
+      if (size() * a.size() > 64)         // dense chords, lyrics
+            return sweepHorizontalDistance(*this, a);
+
       qreal dist = -1000000.0;      // min real
       for (const QRectF& r2 : a) {
             qreal by1 = r2.top();
@@ -27,6 +27,73 @@ static const qreal MINIMUM_Y = -1000000.0;
 #endif
 
 
+//---------------------------------------------------------
+//   SkylineSegments::upperBound
+//    the block and index of the first segment right of x,
+//    as std::upper_bound() over all segments
+//---------------------------------------------------------
+
+std::pair<size_t, size_t> SkylineSegments::upperBound(qreal x) const
+      {
+      auto b = std::upper_bound(_blocks.begin(), _blocks.end(), x, [](qreal x, const Block& b) { return x < b.front().x; });
+      if (b == _blocks.begin())
+            return { 0, 0 };
+      --b;
+      auto i = std::upper_bound(b->begin(), b->end(), x, [](qreal x, const SkylineSegment& s) { return x < s.x; });
+      if (i == b->end())
+            return { size_t(b - _blocks.begin()) + 1, 0 };
+      return { size_t(b - _blocks.begin()), size_t(i - b->begin()) };
+      }
+
+SkylineSegments::iterator SkylineSegments::upper_bound(qreal x)
+      {
+      std::pair<size_t, size_t> p = upperBound(x);
+      return iterator(&_blocks, p.first, p.second);
+      }
+
+//---------------------------------------------------------
+//   SkylineSegments::insert
+//---------------------------------------------------------
+
+SkylineSegments::iterator SkylineSegments::insert(iterator i, const SkylineSegment& s)
+      {
+      if (_blocks.empty()) {
+            push_back(s);
+            return begin();
+            }
+      size_t block = i._block;
+      size_t idx   = i._idx;
+      if (block == _blocks.size()) {      // end()
+            --block;
+            idx = _blocks[block].size();
+            }
+      Block& b = _blocks[block];
+      b.insert(b.begin() + idx, s);
+      if (b.size() > 2 * BLOCK_SIZE) {
+            Block nb(b.begin() + BLOCK_SIZE, b.end());
+            b.erase(b.begin() + BLOCK_SIZE, b.end());
+            _blocks.insert(_blocks.begin() + block + 1, std::move(nb));
+            if (idx >= BLOCK_SIZE) {
+                  ++block;
+                  idx -= BLOCK_SIZE;
+                  }
+            }
+      return iterator(&_blocks, block, idx);
+      }
+
+//---------------------------------------------------------
+//   SkylineSegments::push_back
+//---------------------------------------------------------
+
+void SkylineSegments::push_back(const SkylineSegment& s)
+      {
+      if (_blocks.empty() || _blocks.back().size() >= 2 * BLOCK_SIZE) {
+            _blocks.emplace_back();
+            _blocks.back().reserve(BLOCK_SIZE);
+            }
+      _blocks.back().push_back(s);
+      }
+
 //---------------------------------------------------------
 //   add
 //---------------------------------------------------------
@@ -48,7 +115,7 @@ SkylineLine::SegIter SkylineLine::insert(SegIter i, qreal x, qreal y, qreal w)
       // in SkylineLine::add().
       if (i != seg.end() && xr > i->x)
             i->x = xr;
-      return seg.emplace(i, x, y, w);
+      return seg.insert(i, SkylineSegment(x, y, w));
       }
 
 //---------------------------------------------------------
@@ -57,7 +124,7 @@ SkylineLine::SegIter SkylineLine::insert(SegIter i, qreal x, qreal y, qreal w)
 
 void SkylineLine::append(qreal x, qreal y, qreal w)
       {
-      seg.emplace_back(x, y, w);
+      seg.push_back(SkylineSegment(x, y, w));
       }
 
 //---------------------------------------------------------
@@ -66,17 +133,12 @@ void SkylineLine::append(qreal x, qreal y, qreal w)
 
 SkylineLine::SegIter SkylineLine::find(qreal x)
       {
-      auto it = std::upper_bound(seg.begin(), seg.end(), x, [](qreal x, const SkylineSegment& s) { return x < s.x; });
+      auto it = seg.upper_bound(x);
       if (it == seg.begin())
             return it;
       return (--it);
       }
 
-SkylineLine::SegConstIter SkylineLine::find(qreal x) const
-      {
-      return const_cast<SkylineLine*>(this)->find(x);
-      }
-
 //---------------------------------------------------------
 //   add
 //---------------------------------------------------------
@@ -34,20 +34,76 @@ struct SkylineSegment {
       SkylineSegment(qreal _x, qreal _y, qreal _w) : x(_x), y(_y), w(_w) {}
       };
 
+//---------------------------------------------------------
+//   SkylineSegments
+//    the segments of a SkylineLine in short blocks, so an
+//    insertion only moves the tail of its block
+//---------------------------------------------------------
+
+class SkylineSegments {
+      static const size_t BLOCK_SIZE = 32;      // a block is split when it grows beyond 2 * BLOCK_SIZE
+      typedef std::vector<SkylineSegment> Block;
+      std::vector<Block> _blocks;               // none of them empty
+
+      template <class Blocks, class Segment>
+      class Iterator {
+            Blocks* _blocks;
+            size_t _block;
+            size_t _idx;
+            friend class SkylineSegments;
+
+         public:
+            Iterator(Blocks* b, size_t block, size_t idx) : _blocks(b), _block(block), _idx(idx) {}
+            Segment& operator*() const  { return (*_blocks)[_block][_idx];  }
+            Segment* operator->() const { return &(*_blocks)[_block][_idx]; }
+            Iterator& operator++() {
+                  if (++_idx == (*_blocks)[_block].size()) {
+                        ++_block;
+                        _idx = 0;
+                        }
+                  return *this;
+                  }
+            Iterator& operator--() {
+                  if (_idx == 0)
+                        _idx = (*_blocks)[--_block].size();
+                  --_idx;
+                  return *this;
+                  }
+            bool operator==(const Iterator& i) const { return _block == i._block && _idx == i._idx; }
+            bool operator!=(const Iterator& i) const { return !(*this == i); }
+            };
+
+      std::pair<size_t, size_t> upperBound(qreal x) const;
+
+   public:
+      typedef Iterator<std::vector<Block>, SkylineSegment> iterator;
+      typedef Iterator<const std::vector<Block>, const SkylineSegment> const_iterator;
+
+      iterator begin()             { return iterator(&_blocks, 0, 0); }
+      iterator end()               { return iterator(&_blocks, _blocks.size(), 0); }
+      const_iterator begin() const { return const_iterator(&_blocks, 0, 0); }
+      const_iterator end() const   { return const_iterator(&_blocks, _blocks.size(), 0); }
+
+      bool empty() const           { return _blocks.empty(); }
+      void clear()                 { _blocks.clear(); }
+      iterator insert(iterator i, const SkylineSegment& s);
+      void push_back(const SkylineSegment& s);
+      iterator upper_bound(qreal x);
+      };
+
 //---------------------------------------------------------
 //   SkylineLine
 //---------------------------------------------------------
 
 class SkylineLine {
       const bool north;
-      std::vector<SkylineSegment> seg;
-      typedef std::vector<SkylineSegment>::iterator SegIter;
-      typedef std::vector<SkylineSegment>::const_iterator SegConstIter;
+      SkylineSegments seg;
+      typedef SkylineSegments::iterator SegIter;
+      typedef SkylineSegments::const_iterator SegConstIter;
 
       SegIter insert(SegIter i, qreal x, qreal y, qreal w);
       void append(qreal x, qreal y, qreal w);
       SegIter find(qreal x);
-      SegConstIter find(qreal x) const;
 
    public:
       SkylineLine(bool n) : north(n) {}
@@ -350,17 +350,24 @@ void SlurTieSegment::read(XmlReader& e)
       {
       qreal _spatium = score()->spatium();
       while (e.readNextStartElement()) {
-            const QStringRef& tag(e.name());
-            if (tag == "o1")
-                  ups(Grip::START).off = e.readPoint() * _spatium;
-            else if (tag == "o2")
-                  ups(Grip::BEZIER1).off = e.readPoint() * _spatium;
-            else if (tag == "o3")
-                  ups(Grip::BEZIER2).off = e.readPoint() * _spatium;
-            else if (tag == "o4")
-                  ups(Grip::END).off = e.readPoint() * _spatium;
-            else if (!Element::readProperties(e))
-                  e.unknown();
+            switch (e.tag()) {
+                  case XmlTag::O1:
+                        ups(Grip::START).off = e.readPoint() * _spatium;
+                        break;
+                  case XmlTag::O2:
+                        ups(Grip::BEZIER1).off = e.readPoint() * _spatium;
+                        break;
+                  case XmlTag::O3:
+                        ups(Grip::BEZIER2).off = e.readPoint() * _spatium;
+                        break;
+                  case XmlTag::O4:
+                        ups(Grip::END).off = e.readPoint() * _spatium;
+                        break;
+                  default:
+                        if (!Element::readProperties(e))
+                              e.unknown();
+                        break;
+                  }
             }
       }
 
@@ -447,23 +454,27 @@ void SlurTie::writeProperties(XmlWriter& xml) const
 
 bool SlurTie::readProperties(XmlReader& e)
       {
-      const QStringRef& tag(e.name());
-
-      if (readProperty(tag, e, Pid::SLUR_DIRECTION))
-            ;
-      else if (tag == "lineType")
-            _lineType = e.readInt();
-      else if (tag == "SlurSegment" || tag == "TieSegment") {
-            const int idx = e.intAttribute("no", 0);
-            const int n = int(spannerSegments().size());
-            for (int i = n; i < idx; ++i)
-                  add(newSlurTieSegment());
-            SlurTieSegment* s = newSlurTieSegment();
-            s->read(e);
-            add(s);
+      switch (e.tag()) {
+            case XmlTag::UP:
+                  readProperty(e, Pid::SLUR_DIRECTION);
+                  break;
+            case XmlTag::LINE_TYPE:
+                  _lineType = e.readInt();
+                  break;
+            case XmlTag::SLUR_SEGMENT:
+            case XmlTag::TIE_SEGMENT: {
+                  const int idx = e.intAttribute("no", 0);
+                  const int n = int(spannerSegments().size());
+                  for (int i = n; i < idx; ++i)
+                        add(newSlurTieSegment());
+                  SlurTieSegment* s = newSlurTieSegment();
+                  s->read(e);
+                  add(s);
+                  }
+                  break;
+            default:
+                  return Element::readProperties(e);
             }
-      else if (!Element::readProperties(e))
-            return false;
       return true;
       }
 
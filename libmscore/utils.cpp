@@ -40,6 +40,67 @@ QRectF handleRect(const QPointF& pos)
       return QRectF(pos.x()-4, pos.y()-4, 8, 8);
       }
 
+//---------------------------------------------------------
+//   MeasureIndex::build
+//---------------------------------------------------------
+
+void MeasureIndex::build(Measure* first, int generation, bool mmRests)
+      {
+      _measures.clear();
+      for (Measure* m = first; m; m = mmRests ? m->nextMeasureMM() : m->nextMeasure())
+            _measures.append(m);
+      _generation = generation;
+      _mmRests    = mmRests;
+      }
+
+//---------------------------------------------------------
+//   MeasureIndex::search
+//    return the index of the last measure starting at or
+//    before tick, -1 if there is none
+//---------------------------------------------------------
+
+int MeasureIndex::search(const Fraction& tick) const
+      {
+      auto i = std::upper_bound(_measures.begin(), _measures.end(), tick,
+         [](const Fraction& t, const Measure* m) { return t < m->tick(); });
+      return int(i - _measures.begin()) - 1;
+      }
+
+//---------------------------------------------------------
+//   MeasureIndex::linked
+//    check the measure at idx against the links of the
+//    score, in case they were changed without the
+//    MeasureBaseList
+//---------------------------------------------------------
+
+bool MeasureIndex::linked(int idx, Measure* first) const
+      {
+      Measure* m  = _measures[idx];
+      Measure* pm = idx > 0 ? _measures[idx - 1] : 0;
+      Measure* nm = idx + 1 < _measures.size() ? _measures[idx + 1] : 0;
+      if (_mmRests)
+            return (pm ? pm->nextMeasureMM() : first) == m && m->nextMeasureMM() == nm;
+      return (pm ? pm->nextMeasure() : first) == m && m->nextMeasure() == nm;
+      }
+
+//---------------------------------------------------------
+//   MeasureIndex::find
+//    return the last measure starting at or before tick,
+//    the index is rebuilt if the measure list changed
+//---------------------------------------------------------
+
+Measure* MeasureIndex::find(const Fraction& tick, Measure* first, int generation, bool mmRests)
+      {
+      if (_generation != generation || _mmRests != mmRests)
+            build(first, generation, mmRests);
+      int idx = search(tick);
+      if (idx >= 0 && !linked(idx, first)) {
+            build(first, generation, mmRests);
+            idx = search(tick);
+            }
+      return idx >= 0 ? _measures[idx] : 0;
+      }
+
 //---------------------------------------------------------
 //   tick2measure
 //---------------------------------------------------------
@@ -51,17 +112,13 @@ Measure* Score::tick2measure(const Fraction& tick) const
       if (tick <= Fraction(0,1))
             return firstMeasure();
 
-      Measure* lm = 0;
-      for (Measure* m = firstMeasure(); m; m = m->nextMeasure()) {
-            if (tick < m->tick()) {
-                  Q_ASSERT(lm);
-                  return lm;
-                  }
-            lm = m;
-            }
+      Measure* first = firstMeasure();
+      Measure* m = _measureIndex.find(tick, first, _measures.generation(), false);
+      Q_ASSERT(m || !first);        // a score without measures has none to find
+      if (m && (m->nextMeasure() || tick <= m->endTick()))
+            return m;
       // check last measure
-      if (lm && (tick >= lm->tick()) && (tick <= lm->endTick()))
-            return lm;
+      Measure* lm = lastMeasure();
       qDebug("tick2measure %d (max %d) not found", tick.ticks(), lm ? lm->tick().ticks() : -1);
       return 0;
       }
@@ -78,18 +135,13 @@ Measure* Score::tick2measureMM(const Fraction& t) const
       if (tick < Fraction(0,1))
             tick = Fraction(0,1);
 
-      Measure* lm = 0;
-
-      for (Measure* m = firstMeasureMM(); m; m = m->nextMeasureMM()) {
-            if (tick < m->tick()) {
-                  Q_ASSERT(lm);
-                  return lm;
-                  }
-            lm = m;
-            }
+      Measure* first = firstMeasureMM();
+      Measure* m = _measureIndexMM.find(tick, first, _measures.generation(), styleB(Sid::createMultiMeasureRests));
+      Q_ASSERT(m || !first);
+      if (m && (m->nextMeasureMM() || tick <= m->endTick()))
+            return m;
       // check last measure
-      if (lm && (tick >= lm->tick()) && (tick <= lm->endTick()))
-            return lm;
+      Measure* lm = lastMeasureMM();
       qDebug("tick2measureMM %d (max %d) not found", tick.ticks(), lm ? lm->tick().ticks() : -1);
       return 0;
       }
@@ -100,12 +152,12 @@ Measure* Score::tick2measureMM(const Fraction& t) const
 
 MeasureBase* Score::tick2measureBase(const Fraction& tick) const
       {
-      for (MeasureBase* mb = first(); mb; mb = mb->next()) {
-            Fraction st = mb->tick();
-            Fraction l  = mb->ticks();
-            if (tick >= st && tick < (st+l))
-                  return mb;
-            }
+      // frames have no length, only a measure can contain tick
+      if (tick < Fraction(0,1))
+            return 0;
+      Measure* m = _measureIndex.find(tick, firstMeasure(), _measures.generation(), false);
+      if (m && tick < m->endTick())
+            return m;
 //      qDebug("tick2measureBase %d not found", tick);
       return 0;
       }
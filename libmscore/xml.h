@@ -50,6 +50,44 @@ struct TextStyleMap {
       Tid ss;
       };
 
+//---------------------------------------------------------
+//   XmlTag
+//    ids of the element names that the hot MSCX readers
+//    dispatch on, see XmlReader::tag()
+//---------------------------------------------------------
+
+enum class XmlTag : unsigned char {
+      UNKNOWN,
+      ACCIACCATURA, ACCIDENTAL, AMBITUS, APPOGGIATURA, ARPEGGIO, ARTICULATION, AUTOPLACE,
+      BAR_LINE, BEAM, BEAM_MODE, BEND, BREAK_MULTI_MEASURE_REST, BREATH,
+      CHORD, CHORD_LINE, CLEF, COLOR,
+      DISTRIBUTE, DOTS, DOT_POSITION, DURATION, DURATION_TYPE, DYNAMIC,
+      END_REPEAT, END_TUPLET, EVENTS,
+      FERMATA, FIGURED_BASS, FINGERING, FIXED, FIXED_LINE, FRAGMENT, FRET, FRET_DIAGRAM,
+      GHOST, GRACE16, GRACE16_AFTER, GRACE32, GRACE32_AFTER, GRACE4, GRACE8_AFTER, GROW_LEFT,
+      GROW_RIGHT,
+      HARMONY, HEAD, HEAD_SCHEME, HEAD_TYPE, HOOK,
+      IMAGE, INSTRUMENT_CHANGE, IRREGULAR,
+      JUMP,
+      KEY_SIG,
+      L1, L2, LEADING_SPACE, LID, LINE, LINE_TYPE, LINKED, LINKED_MAIN, LOCATION, LYRICS,
+      MARKER, MEASURE_NUMBER, MEASURE_NUMBER_MODE, MIN_DISTANCE, MIRROR, MM_REST_RANGE,
+      MULTI_MEASURE_REST,
+      NOTE, NOTE_DOT, NO_OFFSET, NO_STEM,
+      O1, O2, O3, O4, OFFSET,
+      PITCH, PLACEMENT, PLAY, POS,
+      REHEARSAL_MARK, REPEAT_MEASURE, REST,
+      SEGMENT, SELECTED, SIZE_IS_SPATIUM_DEPENDENT, SLASH_STYLE, SLUR_SEGMENT, SMALL, SPANNER,
+      STAFF_MOVE, STAFF_STATE, STAFF_TEXT, START_REPEAT, STEM, STEMLESS, STEM_DIRECTION,
+      STEM_SLASH, STICKING, STRETCH, STRING, SUBTYPE, SYMBOL, SYSTEM_DIVIDER, SYSTEM_TEXT,
+      TAG, TEMPO, TEXT, TICK, TICKLEN, TICK_OFFSET, TIE_SEGMENT, TIME_SIG, TPC, TPC2, TRACK,
+      TRAILING_SPACE, TREMOLO, TREMOLO_BAR, TUNING, TUPLET,
+      UP,
+      VELOCITY, VELO_TYPE, VISIBLE, VOICE, VSPACER, VSPACER_DOWN, VSPACER_FIXED, VSPACER_UP,
+      Y1, Y2,
+      Z,
+      };
+
 //---------------------------------------------------------
 //   LinksIndexer
 //---------------------------------------------------------
@@ -62,6 +100,18 @@ class LinksIndexer {
       int assignLocalIndex(const Location& mainElementInfo);
       };
 
+//---------------------------------------------------------
+//   XmlLinkContext
+//    links of the master score staves, kept to read
+//    excerpts with another reader after the master score
+//---------------------------------------------------------
+
+struct XmlLinkContext {
+      QMap<int, QList<QPair<LinkedElements*, Location>>> staffLinkedElements;
+      LinksIndexer linksIndexer;
+      QList<TextStyleMap> userTextStyles;
+      };
+
 //---------------------------------------------------------
 //   XmlReader
 //---------------------------------------------------------
@@ -99,6 +149,9 @@ class XmlReader : public QXmlStreamReader {
 
       QList<TextStyleMap> userTextStyles;
 
+      bool readValueText();
+      void skipValueEnd();
+
       void addConnectorInfo(std::unique_ptr<ConnectorInfoReader>);
       void removeConnector(const ConnectorInfoReader*); // Removes the whole ConnectorInfo chain from the connectors list.
 
@@ -116,8 +169,10 @@ class XmlReader : public QXmlStreamReader {
       bool hasAccidental { false };                     // used for userAccidental backward compatibility
       void unknown();
 
+      XmlTag tag() const;
+
       // attribute helper routines:
-      QString attribute(const char* s) const { return attributes().value(s).toString(); }
+      QString attribute(const char* s) const { return attributes().value(QLatin1String(s)).toString(); }
       QString attribute(const char* s, const QString&) const;
       int intAttribute(const char* s) const;
       int intAttribute(const char* s, int _default) const;
@@ -125,12 +180,12 @@ class XmlReader : public QXmlStreamReader {
       double doubleAttribute(const char* s, double _default) const;
       bool hasAttribute(const char* s) const;
 
-      // helper routines based on readElementText():
-      int readInt()            { return readElementText().toInt();      }
-      int readInt(bool* ok)    { return readElementText().toInt(ok);    }
-      int readIntHex()         { return readElementText().toInt(0, 16); }
-      double readDouble()      { return readElementText().toDouble();   }
-      qlonglong readLongLong() { return readElementText().toLongLong(); }
+      // numeric values, read without copying the element text:
+      int readInt()            { return readInt(nullptr); }
+      int readInt(bool* ok);
+      int readIntHex();
+      double readDouble();
+      qlonglong readLongLong();
 
       double readDouble(double min, double max);
       bool readBool();
@@ -197,6 +252,8 @@ class XmlReader : public QXmlStreamReader {
 
       LinkedElements* getLink(bool masterScore, const Location& l, int localIndexDiff);
       void addLink(Staff* staff, LinkedElements* link);
+      XmlLinkContext linkContext() const;
+      void setLinkContext(const XmlLinkContext&);
       QMap<int, LinkedElements*>& linkIds() { return _elinks;     }
       QMultiMap<int, int>& tracks()         { return _tracks;     }
 
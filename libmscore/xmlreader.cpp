@@ -38,22 +38,228 @@ XmlReader::~XmlReader()
             }
       }
 
+//---------------------------------------------------------
+//   XmlTagName
+//---------------------------------------------------------
+
+struct XmlTagName {
+      XmlTag tag;
+      const char* name;
+      };
+
+static const XmlTagName xmlTagNames[] = {
+      { XmlTag::ACCIACCATURA,              "acciaccatura" },
+      { XmlTag::ACCIDENTAL,                "Accidental" },
+      { XmlTag::AMBITUS,                   "Ambitus" },
+      { XmlTag::APPOGGIATURA,              "appoggiatura" },
+      { XmlTag::ARPEGGIO,                  "Arpeggio" },
+      { XmlTag::ARTICULATION,              "Articulation" },
+      { XmlTag::AUTOPLACE,                 "autoplace" },
+      { XmlTag::BAR_LINE,                  "BarLine" },
+      { XmlTag::BEAM,                      "Beam" },
+      { XmlTag::BEAM_MODE,                 "BeamMode" },
+      { XmlTag::BEND,                      "Bend" },
+      { XmlTag::BREAK_MULTI_MEASURE_REST,  "breakMultiMeasureRest" },
+      { XmlTag::BREATH,                    "Breath" },
+      { XmlTag::CHORD,                     "Chord" },
+      { XmlTag::CHORD_LINE,                "ChordLine" },
+      { XmlTag::CLEF,                      "Clef" },
+      { XmlTag::COLOR,                     "color" },
+      { XmlTag::DISTRIBUTE,                "distribute" },
+      { XmlTag::DOTS,                      "dots" },
+      { XmlTag::DOT_POSITION,              "dotPosition" },
+      { XmlTag::DURATION,                  "duration" },
+      { XmlTag::DURATION_TYPE,             "durationType" },
+      { XmlTag::DYNAMIC,                   "Dynamic" },
+      { XmlTag::END_REPEAT,                "endRepeat" },
+      { XmlTag::END_TUPLET,                "endTuplet" },
+      { XmlTag::EVENTS,                    "Events" },
+      { XmlTag::FERMATA,                   "Fermata" },
+      { XmlTag::FIGURED_BASS,              "FiguredBass" },
+      { XmlTag::FINGERING,                 "Fingering" },
+      { XmlTag::FIXED,                     "fixed" },
+      { XmlTag::FIXED_LINE,                "fixedLine" },
+      { XmlTag::FRAGMENT,                  "Fragment" },
+      { XmlTag::FRET,                      "fret" },
+      { XmlTag::FRET_DIAGRAM,              "FretDiagram" },
+      { XmlTag::GHOST,                     "ghost" },
+      { XmlTag::GRACE16,                   "grace16" },
+      { XmlTag::GRACE16_AFTER,             "grace16after" },
+      { XmlTag::GRACE32,                   "grace32" },
+      { XmlTag::GRACE32_AFTER,             "grace32after" },
+      { XmlTag::GRACE4,                    "grace4" },
+      { XmlTag::GRACE8_AFTER,              "grace8after" },
+      { XmlTag::GROW_LEFT,                 "growLeft" },
+      { XmlTag::GROW_RIGHT,                "growRight" },
+      { XmlTag::HARMONY,                   "Harmony" },
+      { XmlTag::HEAD,                      "head" },
+      { XmlTag::HEAD_SCHEME,               "headScheme" },
+      { XmlTag::HEAD_TYPE,                 "headType" },
+      { XmlTag::HOOK,                      "Hook" },
+      { XmlTag::IMAGE,                     "Image" },
+      { XmlTag::INSTRUMENT_CHANGE,         "InstrumentChange" },
+      { XmlTag::IRREGULAR,                 "irregular" },
+      { XmlTag::JUMP,                      "Jump" },
+      { XmlTag::KEY_SIG,                   "KeySig" },
+      { XmlTag::L1,                        "l1" },
+      { XmlTag::L2,                        "l2" },
+      { XmlTag::LEADING_SPACE,             "leadingSpace" },
+      { XmlTag::LID,                       "lid" },
+      { XmlTag::LINE,                      "line" },
+      { XmlTag::LINE_TYPE,                 "lineType" },
+      { XmlTag::LINKED,                    "linked" },
+      { XmlTag::LINKED_MAIN,               "linkedMain" },
+      { XmlTag::LOCATION,                  "location" },
+      { XmlTag::LYRICS,                    "Lyrics" },
+      { XmlTag::MARKER,                    "Marker" },
+      { XmlTag::MEASURE_NUMBER,            "MeasureNumber" },
+      { XmlTag::MEASURE_NUMBER_MODE,       "measureNumberMode" },
+      { XmlTag::MIN_DISTANCE,              "minDistance" },
+      { XmlTag::MIRROR,                    "mirror" },
+      { XmlTag::MM_REST_RANGE,             "MMRestRange" },
+      { XmlTag::MULTI_MEASURE_REST,        "multiMeasureRest" },
+      { XmlTag::NOTE,                      "Note" },
+      { XmlTag::NOTE_DOT,                  "NoteDot" },
+      { XmlTag::NO_OFFSET,                 "noOffset" },
+      { XmlTag::NO_STEM,                   "noStem" },
+      { XmlTag::O1,                        "o1" },
+      { XmlTag::O2,                        "o2" },
+      { XmlTag::O3,                        "o3" },
+      { XmlTag::O4,                        "o4" },
+      { XmlTag::OFFSET,                    "offset" },
+      { XmlTag::PITCH,                     "pitch" },
+      { XmlTag::PLACEMENT,                 "placement" },
+      { XmlTag::PLAY,                      "play" },
+      { XmlTag::POS,                       "pos" },
+      { XmlTag::REHEARSAL_MARK,            "RehearsalMark" },
+      { XmlTag::REPEAT_MEASURE,            "RepeatMeasure" },
+      { XmlTag::REST,                      "Rest" },
+      { XmlTag::SEGMENT,                   "Segment" },
+      { XmlTag::SELECTED,                  "selected" },
+      { XmlTag::SIZE_IS_SPATIUM_DEPENDENT, "sizeIsSpatiumDependent" },
+      { XmlTag::SLASH_STYLE,               "slashStyle" },
+      { XmlTag::SLUR_SEGMENT,              "SlurSegment" },
+      { XmlTag::SMALL,                     "small" },
+      { XmlTag::SPANNER,                   "Spanner" },
+      { XmlTag::STAFF_MOVE,                "staffMove" },
+      { XmlTag::STAFF_STATE,               "StaffState" },
+      { XmlTag::STAFF_TEXT,                "StaffText" },
+      { XmlTag::START_REPEAT,              "startRepeat" },
+      { XmlTag::STEM,                      "Stem" },
+      { XmlTag::STEMLESS,                  "stemless" },
+      { XmlTag::STEM_DIRECTION,            "StemDirection" },
+      { XmlTag::STEM_SLASH,                "StemSlash" },
+      { XmlTag::STICKING,                  "Sticking" },
+      { XmlTag::STRETCH,                   "stretch" },
+      { XmlTag::STRING,                    "string" },
+      { XmlTag::SUBTYPE,                   "subtype" },
+      { XmlTag::SYMBOL,                    "Symbol" },
+      { XmlTag::SYSTEM_DIVIDER,            "SystemDivider" },
+      { XmlTag::SYSTEM_TEXT,               "SystemText" },
+      { XmlTag::TAG,                       "tag" },
+      { XmlTag::TEMPO,                     "Tempo" },
+      { XmlTag::TEXT,                      "Text" },
+      { XmlTag::TICK,                      "tick" },
+      { XmlTag::TICKLEN,                   "ticklen" },
+      { XmlTag::TICK_OFFSET,               "tickOffset" },
+      { XmlTag::TIE_SEGMENT,               "TieSegment" },
+      { XmlTag::TIME_SIG,                  "TimeSig" },
+      { XmlTag::TPC,                       "tpc" },
+      { XmlTag::TPC2,                      "tpc2" },
+      { XmlTag::TRACK,                     "track" },
+      { XmlTag::TRAILING_SPACE,            "trailingSpace" },
+      { XmlTag::TREMOLO,                   "Tremolo" },
+      { XmlTag::TREMOLO_BAR,               "TremoloBar" },
+      { XmlTag::TUNING,                    "tuning" },
+      { XmlTag::TUPLET,                    "Tuplet" },
+      { XmlTag::UP,                        "up" },
+      { XmlTag::VELOCITY,                  "velocity" },
+      { XmlTag::VELO_TYPE,                 "veloType" },
+      { XmlTag::VISIBLE,                   "visible" },
+      { XmlTag::VOICE,                     "voice" },
+      { XmlTag::VSPACER,                   "vspacer" },
+      { XmlTag::VSPACER_DOWN,              "vspacerDown" },
+      { XmlTag::VSPACER_FIXED,             "vspacerFixed" },
+      { XmlTag::VSPACER_UP,                "vspacerUp" },
+      { XmlTag::Y1,                        "y1" },
+      { XmlTag::Y2,                        "y2" },
+      { XmlTag::Z,                         "z" },
+      };
+
+//---------------------------------------------------------
+//   XmlTagTable
+//    open addressing hash table from element name to XmlTag,
+//    built once; the size keeps probe sequences short
+//---------------------------------------------------------
+
+class XmlTagTable {
+      static const int SIZE = 512;        // power of two, about four times the number of tags
+      unsigned char _slots[SIZE];         // index into xmlTagNames + 1, 0 for an empty slot
+
+   public:
+      XmlTagTable()
+            {
+            static_assert(sizeof(xmlTagNames) / sizeof(*xmlTagNames) < SIZE / 2, "XmlTagTable too small");
+            std::fill(_slots, _slots + SIZE, 0);
+            int idx = 0;
+            for (const XmlTagName& n : xmlTagNames) {
+                  uint i = qHash(QString::fromLatin1(n.name)) & (SIZE - 1);
+                  while (_slots[i])
+                        i = (i + 1) & (SIZE - 1);
+                  _slots[i] = ++idx;
+                  }
+            }
+
+      XmlTag find(const QStringRef& name) const
+            {
+            for (uint i = qHash(name) & (SIZE - 1); _slots[i]; i = (i + 1) & (SIZE - 1)) {
+                  const XmlTagName& n = xmlTagNames[_slots[i] - 1];
+                  if (name == QLatin1String(n.name))
+                        return n.tag;
+                  }
+            return XmlTag::UNKNOWN;
+            }
+      };
+
+//---------------------------------------------------------
+//   tag
+//    id of the current element name, XmlTag::UNKNOWN
+//    for names the readers still compare as strings
+//---------------------------------------------------------
+
+XmlTag XmlReader::tag() const
+      {
+      static const XmlTagTable table;
+      return table.find(name());
+      }
+
+//---------------------------------------------------------
+//   findAttribute
+//---------------------------------------------------------
+
+static const QXmlStreamAttribute* findAttribute(const QXmlStreamAttributes& a, const char* s)
+      {
+      for (const QXmlStreamAttribute& attr : a) {
+            if (attr.qualifiedName() == QLatin1String(s))
+                  return &attr;
+            }
+      return nullptr;
+      }
+
 //---------------------------------------------------------
 //   intAttribute
 //---------------------------------------------------------
 
 int XmlReader::intAttribute(const char* s, int _default) const
       {
-      if (attributes().hasAttribute(s))
-            // return attributes().value(s).toString().toInt();
-            return attributes().value(s).toInt();
-      else
-            return _default;
+      const QXmlStreamAttributes a = attributes();
+      const QXmlStreamAttribute* attr = findAttribute(a, s);
+      return attr ? attr->value().toInt() : _default;
       }
 
 int XmlReader::intAttribute(const char* s) const
       {
-      return attributes().value(s).toInt();
+      return attributes().value(QLatin1String(s)).toInt();
       }
 
 //---------------------------------------------------------
@@ -62,15 +268,14 @@ int XmlReader::intAttribute(const char* s) const
 
 double XmlReader::doubleAttribute(const char* s) const
       {
-      return attributes().value(s).toDouble();
+      return attributes().value(QLatin1String(s)).toDouble();
       }
 
 double XmlReader::doubleAttribute(const char* s, double _default) const
       {
-      if (attributes().hasAttribute(s))
-            return attributes().value(s).toDouble();
-      else
-            return _default;
+      const QXmlStreamAttributes a = attributes();
+      const QXmlStreamAttribute* attr = findAttribute(a, s);
+      return attr ? attr->value().toDouble() : _default;
       }
 
 //---------------------------------------------------------
@@ -79,10 +284,9 @@ double XmlReader::doubleAttribute(const char* s, double _default) const
 
 QString XmlReader::attribute(const char* s, const QString& _default) const
       {
-      if (attributes().hasAttribute(s))
-            return attributes().value(s).toString();
-      else
-            return _default;
+      const QXmlStreamAttributes a = attributes();
+      const QXmlStreamAttribute* attr = findAttribute(a, s);
+      return attr ? attr->value().toString() : _default;
       }
 
 //---------------------------------------------------------
@@ -91,7 +295,112 @@ QString XmlReader::attribute(const char* s, const QString& _default) const
 
 bool XmlReader::hasAttribute(const char* s) const
       {
-      return attributes().hasAttribute(s);
+      return attributes().hasAttribute(QLatin1String(s));
+      }
+
+//---------------------------------------------------------
+//   readValueText
+//    Move from the start tag of a value element to its
+//    character data, which text() then refers to without a
+//    copy. Returns false if there is none; the reader is
+//    then at the end tag.
+//---------------------------------------------------------
+
+bool XmlReader::readValueText()
+      {
+      if (!isStartElement())
+            return false;
+      for (;;) {
+            switch (readNext()) {
+                  case QXmlStreamReader::Characters:
+                        return true;
+                  case QXmlStreamReader::Comment:
+                  case QXmlStreamReader::ProcessingInstruction:
+                        break;
+                  case QXmlStreamReader::StartElement:
+                        unknown();
+                        break;
+                  case QXmlStreamReader::EndElement:
+                        return false;
+                  default:
+                        if (!atEnd())
+                              skipValueEnd();
+                        return false;
+                  }
+            }
+      }
+
+//---------------------------------------------------------
+//   skipValueEnd
+//    Move from the character data of a value element to its
+//    end tag. Only the first run of character data makes up
+//    the value; MuseScore never writes more than one.
+//---------------------------------------------------------
+
+void XmlReader::skipValueEnd()
+      {
+      while (readNext() != QXmlStreamReader::EndElement && !atEnd()) {
+            if (isStartElement())
+                  unknown();
+            }
+      }
+
+//---------------------------------------------------------
+//   readInt
+//---------------------------------------------------------
+
+int XmlReader::readInt(bool* ok)
+      {
+      int val = 0;
+      if (readValueText()) {
+            val = text().toInt(ok);
+            skipValueEnd();
+            }
+      else if (ok)
+            *ok = false;
+      return val;
+      }
+
+//---------------------------------------------------------
+//   readIntHex
+//---------------------------------------------------------
+
+int XmlReader::readIntHex()
+      {
+      int val = 0;
+      if (readValueText()) {
+            val = text().toInt(0, 16);
+            skipValueEnd();
+            }
+      return val;
+      }
+
+//---------------------------------------------------------
+//   readDouble
+//---------------------------------------------------------
+
+double XmlReader::readDouble()
+      {
+      double val = 0.0;
+      if (readValueText()) {
+            val = text().toDouble();
+            skipValueEnd();
+            }
+      return val;
+      }
+
+//---------------------------------------------------------
+//   readLongLong
+//---------------------------------------------------------
+
+qlonglong XmlReader::readLongLong()
+      {
+      qlonglong val = 0;
+      if (readValueText()) {
+            val = text().toLongLong();
+            skipValueEnd();
+            }
+      return val;
       }
 
 //---------------------------------------------------------
@@ -179,18 +488,20 @@ QRectF XmlReader::readRect()
 Fraction XmlReader::readFraction()
       {
       Q_ASSERT(tokenType() == QXmlStreamReader::StartElement);
-      int z = attribute("z", "0").toInt();
-      int n = attribute("n", "1").toInt();
-      const QString& s(readElementText());
-      if (!s.isEmpty()) {
-            int i = s.indexOf('/');
-            if (i == -1) {
-                  return Fraction::fromTicks(s.toInt());
-                  }
+      int z = intAttribute("z", 0);
+      int n = intAttribute("n", 1);
+      if (readValueText()) {
+            const QStringRef s = text();
+            const int i = s.indexOf('/');
+            if (i == -1)
+                  z = s.toInt();
             else {
-                  z = s.leftRef(i).toInt();
-                  n = s.midRef(i+1).toInt();
+                  z = s.left(i).toInt();
+                  n = s.mid(i + 1).toInt();
                   }
+            skipValueEnd();
+            if (i == -1)
+                  return Fraction::fromTicks(z);
             }
       return Fraction(z, n);
       }
@@ -296,7 +607,7 @@ void XmlReader::addTuplet(Tuplet* s)
 
 double XmlReader::readDouble(double min, double max)
       {
-      double val = readElementText().toDouble();
+      double val = readDouble();
       if (val < min)
             val = min;
       else if (val > max)
@@ -707,6 +1018,34 @@ LinkedElements* XmlReader::getLink(bool masterScore, const Location& l, int loca
       return nullptr;
       }
 
+//---------------------------------------------------------
+//   linkContext
+//    return the links of the master score staves read so far
+//---------------------------------------------------------
+
+XmlLinkContext XmlReader::linkContext() const
+      {
+      XmlLinkContext ctx;
+      for (auto i = _staffLinkedElements.cbegin(); i != _staffLinkedElements.cend(); ++i) {
+            if (i.key() >= 0)
+                  ctx.staffLinkedElements.insert(i.key(), i.value());
+            }
+      ctx.linksIndexer   = _linksIndexer;
+      ctx.userTextStyles = userTextStyles;
+      return ctx;
+      }
+
+//---------------------------------------------------------
+//   setLinkContext
+//---------------------------------------------------------
+
+void XmlReader::setLinkContext(const XmlLinkContext& ctx)
+      {
+      _staffLinkedElements = ctx.staffLinkedElements;
+      _linksIndexer        = ctx.linksIndexer;
+      userTextStyles       = ctx.userTextStyles;
+      }
+
 //---------------------------------------------------------
 //   assignLocalIndex
 //---------------------------------------------------------
@@ -0,0 +1,572 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  Copyright (C) 2011 Werner Schweer and others
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2
+//  as published by the Free Software Foundation and appearing in
+//  the file LICENSE.GPL
+//=============================================================================
+
+#include "libmscore/score.h"
+#include "libmscore/key.h"
+#include "libmscore/interval.h"
+#include "libmscore/mscore.h"
+#include "libmscore/style.h"
+#include "libmscore/sym.h"
+#include "libmscore/xml.h"
+#include "thirdparty/qzip/qzipreader_p.h"
+
+namespace Ms {
+
+extern QString readRootFile(MQZipReader*, QList<QString>&);
+
+//---------------------------------------------------------
+//   ScanPart
+//    the fields of a <Part> savePartInfoJSON reports
+//---------------------------------------------------------
+
+struct ScanPart {
+      QString longName;
+      QString trackName;
+      QString instrumentId;
+      int program                     { -1 };     // of the first channel
+      int transposeChromatic          { 0 };
+      PreferSharpFlat preferSharpFlat { PreferSharpFlat::DEFAULT };
+      bool show                       { true };
+      bool hasPitchedStaff            { false };
+      bool hasTabStaff                { false };
+      bool hasDrumStaff               { false };
+      int lyricCount                  { 0 };
+      int harmonyCount                { 0 };
+      };
+
+//---------------------------------------------------------
+//   ScanStaff
+//---------------------------------------------------------
+
+struct ScanStaff {
+      int part            { 0 };
+      StaffGroup group    { StaffGroup::STANDARD };
+      Key key             { Key::C };       // at tick 0
+      bool keyIgnored     { false };        // custom or atonal key at tick 0
+      };
+
+//---------------------------------------------------------
+//   ScanScore
+//    what is collected from one <Score> element
+//---------------------------------------------------------
+
+struct ScanScore {
+      QString name;                       // excerpt title
+      QMap<QString, QString> metaTags;
+      std::vector<ScanPart> parts;
+      std::vector<ScanStaff> staves;
+
+      int measures              { 0 };
+      bool hasLyrics            { false };
+      bool hasHarmonies         { false };
+
+      QString timeSig;
+      int timeSigMeasure        { INT_MAX };
+
+      int tempo                 { 0 };
+      QString tempoText;
+      int tempoMeasure          { -1 };
+      bool tempoAmbiguous       { false };  // several tempo texts in the last measure that has one
+
+      QMap<Tid, QString> firstBoxText;    // Score::getText()
+      QMap<Tid, QStringList> frameTexts;  // textFramesData
+
+      double pageHeight;
+      double pageWidth;
+      bool pageTwosided;
+      bool concertPitch;
+
+      std::vector<ScanScore> excerpts;
+
+      ScanScore()
+            {
+            const MStyle& style = MScore::baseStyle();
+            pageHeight   = style.value(Sid::pageHeight).toDouble();
+            pageWidth    = style.value(Sid::pageWidth).toDouble();
+            pageTwosided = style.value(Sid::pageTwosided).toBool();
+            concertPitch = style.value(Sid::concertPitch).toBool();
+            }
+      };
+
+//---------------------------------------------------------
+//   ScanContext
+//    where in the score an element was found
+//---------------------------------------------------------
+
+struct ScanContext {
+      int staffIdx        { 0 };
+      int measureIdx      { -1 };
+      bool firstBox       { false };    // inside the first MeasureBase, which is a VBox
+      bool inFretDiagram  { false };
+      };
+
+//---------------------------------------------------------
+//   plainText
+//    TextBase::plainText() of the xml text s
+//---------------------------------------------------------
+
+static QString plainText(const QString& s)
+      {
+      QString text;
+      QString sym;
+      bool inSym = false;
+      XmlReader e("<text>" + s + "</text>");
+      while (!e.atEnd()) {
+            switch (e.readNext()) {
+                  case QXmlStreamReader::StartElement:
+                        if (e.name() == "sym") {
+                              inSym = true;
+                              sym.clear();
+                              }
+                        break;
+                  case QXmlStreamReader::EndElement:
+                        if (inSym && e.name() == "sym") {
+                              inSym = false;
+                              SymId id = Sym::name2id(sym);
+                              if (id != SymId::noSym) {
+                                    uint code = ScoreFont::fallbackFont()->sym(id).code();
+                                    text += QString::fromUcs4(&code, 1);
+                                    }
+                              }
+                        break;
+                  case QXmlStreamReader::Characters:
+                        if (inSym)
+                              sym += e.text();
+                        else
+                              text += e.text();
+                        break;
+                  default:
+                        break;
+                  }
+            }
+      return text;
+      }
+
+//---------------------------------------------------------
+//   scanElement
+//    anything below <Staff> in the score body
+//---------------------------------------------------------
+
+static void scanElement(XmlReader& e, ScanScore& sc, const ScanContext& ctx)
+      {
+      const QString tag(e.name().toString());
+      ScanPart& part = sc.parts[sc.staves[ctx.staffIdx].part];
+
+      if (tag == "TimeSig") {
+            int n = 0;
+            int d = 0;
+            while (e.readNextStartElement()) {
+                  if (e.name() == "sigN")
+                        n = e.readInt();
+                  else if (e.name() == "sigD")
+                        d = e.readInt();
+                  else
+                        e.skipCurrentElement();
+                  }
+            if (ctx.measureIdx < sc.timeSigMeasure) {
+                  sc.timeSigMeasure = ctx.measureIdx;
+                  sc.timeSig = QString("%1/%2").arg(n).arg(d);
+                  }
+            return;
+            }
+      if (tag == "KeySig") {
+            Key key = Key::C;
+            bool ignored = false;
+            while (e.readNextStartElement()) {
+                  if (e.name() == "accidental")
+                        key = Key(e.readInt());
+                  else if (e.name() == "custom") {
+                        e.readInt();
+                        ignored = true;
+                        }
+                  else if (e.name() == "mode")
+                        ignored = ignored || e.readElementText() == "none";
+                  else
+                        e.skipCurrentElement();
+                  }
+            if (ctx.measureIdx == 0) {
+                  sc.staves[ctx.staffIdx].key = key;
+                  sc.staves[ctx.staffIdx].keyIgnored = ignored;
+                  }
+            return;
+            }
+      if (tag == "Lyrics") {
+            ++part.lyricCount;
+            sc.hasLyrics = true;
+            e.skipCurrentElement();
+            return;
+            }
+      if (tag == "Harmony") {
+            ++part.harmonyCount;
+            if (!ctx.inFretDiagram)
+                  sc.hasHarmonies = true;
+            e.skipCurrentElement();
+            return;
+            }
+
+      ScanContext cctx = ctx;
+      if (tag == "FretDiagram")
+            cctx.inFretDiagram = true;
+
+      Tid tid = Tid::DEFAULT;
+      QString xmlText;
+      bool hasText = false;
+      double tempo = 0.0;
+      while (e.readNextStartElement()) {
+            const QStringRef& t(e.name());
+            if (t == "style")
+                  tid = textStyleFromName(e.readElementText());
+            else if (t == "text") {
+                  xmlText = e.readXml();
+                  hasText = true;
+                  }
+            else if (t == "tempo" && tag == "Tempo")
+                  tempo = e.readDouble();
+            else
+                  scanElement(e, sc, cctx);
+            }
+
+      if (tag == "Tempo") {
+            if (ctx.measureIdx > sc.tempoMeasure) {
+                  sc.tempoMeasure   = ctx.measureIdx;
+                  sc.tempoAmbiguous = false;
+                  sc.tempo          = qRound(tempo * 60);
+                  sc.tempoText      = xmlText;
+                  }
+            else if (ctx.measureIdx == sc.tempoMeasure)
+                  sc.tempoAmbiguous = true;
+            }
+      else if (hasText && (tid == Tid::TITLE || tid == Tid::SUBTITLE || tid == Tid::COMPOSER || tid == Tid::POET)) {
+            QString text = plainText(xmlText);
+            sc.frameTexts[tid].append(text);
+            if (ctx.firstBox && tag == "Text" && !sc.firstBoxText.contains(tid))
+                  sc.firstBoxText.insert(tid, text);
+            }
+      }
+
+//---------------------------------------------------------
+//   scanPart
+//---------------------------------------------------------
+
+static void scanPart(XmlReader& e, ScanScore& sc)
+      {
+      ScanPart part;
+      const int partIdx = int(sc.parts.size());
+      while (e.readNextStartElement()) {
+            const QStringRef& tag(e.name());
+            if (tag == "Staff") {
+                  ScanStaff staff;
+                  staff.part = partIdx;
+                  while (e.readNextStartElement()) {
+                        if (e.name() == "StaffType") {
+                              const QString group = e.attribute("group", "pitched");
+                              if (group == "tablature")
+                                    staff.group = StaffGroup::TAB;
+                              else if (group == "percussion")
+                                    staff.group = StaffGroup::PERCUSSION;
+                              }
+                        e.skipCurrentElement();
+                        }
+                  if (staff.group == StaffGroup::TAB)
+                        part.hasTabStaff = true;
+                  else if (staff.group == StaffGroup::PERCUSSION)
+                        part.hasDrumStaff = true;
+                  else
+                        part.hasPitchedStaff = true;
+                  sc.staves.push_back(staff);
+                  }
+            else if (tag == "Instrument") {
+                  bool firstChannel = true;
+                  while (e.readNextStartElement()) {
+                        const QStringRef& t(e.name());
+                        if (t == "longName") {
+                              if (part.longName.isEmpty())
+                                    part.longName = e.readXml();
+                              else
+                                    e.skipCurrentElement();
+                              }
+                        else if (t == "trackName")
+                              part.trackName = e.readElementText();
+                        else if (t == "instrumentId")
+                              part.instrumentId = e.readElementText();
+                        else if (t == "transposeChromatic")
+                              part.transposeChromatic = e.readInt();
+                        else if (t == "Channel" && firstChannel) {
+                              firstChannel = false;
+                              while (e.readNextStartElement()) {
+                                    if (e.name() == "program") {
+                                          part.program = e.intAttribute("value", -1);
+                                          if (part.program == -1)
+                                                part.program = e.readInt();
+                                          else
+                                                e.skipCurrentElement();
+                                          }
+                                    else
+                                          e.skipCurrentElement();
+                                    }
+                              }
+                        else
+                              e.skipCurrentElement();
+                        }
+                  }
+            else if (tag == "show")
+                  part.show = e.readInt();
+            else if (tag == "preferSharpFlat")
+                  part.preferSharpFlat = e.readElementText() == "sharps" ? PreferSharpFlat::SHARPS : PreferSharpFlat::FLATS;
+            else
+                  e.skipCurrentElement();
+            }
+      sc.parts.push_back(part);
+      }
+
+//---------------------------------------------------------
+//   scanScore
+//    read302 layout: a <Score> holds the style, meta tags,
+//    parts, one <Staff> per staff and the excerpts as
+//    nested <Score> elements
+//---------------------------------------------------------
+
+static void scanScore(XmlReader& e, ScanScore& sc, bool master)
+      {
+      while (e.readNextStartElement()) {
+            const QStringRef& tag(e.name());
+            if (tag == "Style" && master) {
+                  while (e.readNextStartElement()) {
+                        const QStringRef& t(e.name());
+                        if (t == "pageHeight")
+                              sc.pageHeight = e.readDouble();
+                        else if (t == "pageWidth")
+                              sc.pageWidth = e.readDouble();
+                        else if (t == "pageTwosided")
+                              sc.pageTwosided = e.readInt();
+                        else if (t == "concertPitch")
+                              sc.concertPitch = e.readInt();
+                        else
+                              e.skipCurrentElement();
+                        }
+                  }
+            else if (tag == "metaTag") {
+                  QString name = e.attribute("name");
+                  sc.metaTags.insert(name, e.readElementText());
+                  }
+            else if (tag == "work-title")
+                  sc.metaTags.insert("workTitle", e.readElementText());
+            else if (tag == "source")
+                  sc.metaTags.insert("source", e.readElementText());
+            else if (tag == "name" && !master)
+                  sc.name = e.readElementText();
+            else if (tag == "Part")
+                  scanPart(e, sc);
+            else if (tag == "Staff") {
+                  ScanContext ctx;
+                  ctx.staffIdx = e.intAttribute("id", 1) - 1;
+                  if (ctx.staffIdx < 0 || ctx.staffIdx >= int(sc.staves.size())) {
+                        e.skipCurrentElement();
+                        continue;
+                        }
+                  bool first = true;
+                  while (e.readNextStartElement()) {
+                        const QStringRef& t(e.name());
+                        if (t == "Measure") {
+                              ++ctx.measureIdx;
+                              if (ctx.staffIdx == 0)
+                                    ++sc.measures;
+                              }
+                        ctx.firstBox = first && ctx.staffIdx == 0 && t == "VBox";
+                        first = false;
+                        scanElement(e, sc, ctx);
+                        }
+                  }
+            else if (tag == "Score" && master) {
+                  sc.excerpts.emplace_back();
+                  scanScore(e, sc.excerpts.back(), false);
+                  }
+            else
+                  e.skipCurrentElement();
+            }
+      }
+
+//---------------------------------------------------------
+//   partJSON
+//    same as savePartInfoJSON
+//---------------------------------------------------------
+
+static QJsonObject partJSON(const ScanPart& p)
+      {
+      auto boolToString = [](bool b) { return b ? "true" : "false"; };
+      QJsonObject jsonPart;
+      jsonPart.insert("name", QString(p.longName).replace("\n", ""));
+      jsonPart.insert("program", p.program);
+      jsonPart.insert("instrumentId", p.instrumentId);
+      jsonPart.insert("instrumentName", p.trackName);
+      jsonPart.insert("lyricCount", p.lyricCount);
+      jsonPart.insert("harmonyCount", p.harmonyCount);
+      jsonPart.insert("hasPitchedStaff", boolToString(p.hasPitchedStaff));
+      jsonPart.insert("hasTabStaff", boolToString(p.hasTabStaff));
+      jsonPart.insert("hasDrumStaff", boolToString(p.hasDrumStaff));
+      jsonPart.insert("isVisible", boolToString(p.show));
+      return jsonPart;
+      }
+
+static QJsonArray partsJSON(const ScanScore& sc, bool* complete)
+      {
+      QJsonArray parts;
+      for (const ScanPart& p : sc.parts) {
+            // without a program the instrument guesses one on load
+            if (p.program == -1)
+                  *complete = false;
+            parts.append(partJSON(p));
+            }
+      return parts;
+      }
+
+//---------------------------------------------------------
+//   scanMetadataJSON
+//    fill json with the saveMetadataJSON() fields that can
+//    be read off the MSCX/MSCZ file data without building
+//    the score. The file type is taken from the suffix of
+//    name. missing receives the fields that need a loaded
+//    score. Returns false if data cannot be scanned at all.
+//---------------------------------------------------------
+
+bool scanMetadataJSON(const QByteArray& data, const QString& name, QJsonObject* json, QStringList* missing)
+      {
+      QByteArray mscx;
+      if (name.endsWith(".mscz")) {
+            QBuffer buffer(const_cast<QByteArray*>(&data));
+            buffer.open(QIODevice::ReadOnly);
+            MQZipReader uz(&buffer);
+            QList<QString> images;
+            QString rootfile = readRootFile(&uz, images);
+            if (rootfile.isEmpty())
+                  return false;
+            mscx = uz.fileData(rootfile);
+            }
+      else if (name.endsWith(".mscx"))
+            mscx = data;
+      else
+            return false;
+
+      XmlReader e(mscx);
+      QString mscoreVersion;
+      int mscVersion = 0;
+      ScanScore sc;
+      bool found = false;
+      while (e.readNextStartElement()) {
+            if (e.name() != "museScore") {
+                  e.skipCurrentElement();
+                  continue;
+                  }
+            const QStringList sl = e.attribute("version").split('.');
+            if (sl.size() == 2)
+                  mscVersion = sl[0].toInt() * 100 + sl[1].toInt();
+            // older files are converted by read114/read206 on load
+            if (mscVersion < 300 || mscVersion > MSCVERSION)
+                  return false;
+            while (e.readNextStartElement()) {
+                  if (e.name() == "programVersion")
+                        mscoreVersion = e.readElementText();
+                  else if (e.name() == "Score" && !found) {
+                        scanScore(e, sc, true);
+                        found = true;
+                        }
+                  else
+                        e.skipCurrentElement();
+                  }
+            }
+      if (!found || e.hasError())
+            return false;
+
+      auto metaTag = [&sc](const QString& tag) { return sc.metaTags.value(tag); };
+
+      QString title = sc.firstBoxText.value(Tid::TITLE);
+      if (title.isEmpty())
+            title = metaTag("workTitle");
+      if (title.isEmpty())
+            title = QFileInfo(name).completeBaseName();
+      json->insert("title", title);
+      json->insert("subtitle", sc.firstBoxText.value(Tid::SUBTITLE));
+      QString composer = sc.firstBoxText.value(Tid::COMPOSER);
+      if (composer.isEmpty())
+            composer = metaTag("composer");
+      json->insert("composer", composer);
+      QString poet = sc.firstBoxText.value(Tid::POET);
+      if (poet.isEmpty())
+            poet = metaTag("lyricist");
+      json->insert("poet", poet);
+
+      json->insert("mscoreVersion", mscoreVersion);
+      json->insert("fileVersion", mscVersion);
+
+      json->insert("measures", sc.measures);
+      json->insert("hasLyrics", sc.hasLyrics ? "true" : "false");
+      json->insert("hasHarmonies", sc.hasHarmonies ? "true" : "false");
+      json->insert("previousSource", metaTag("source"));
+      json->insert("timesig", sc.timeSig);
+
+      // Score::keysig()
+      Key key = Key::C;
+      for (const ScanStaff& st : sc.staves) {
+            if (st.group == StaffGroup::PERCUSSION || st.keyIgnored)
+                  continue;
+            key = st.key;
+            const ScanPart& part = sc.parts[st.part];
+            if (!sc.concertPitch && part.transposeChromatic)
+                  key = transposeKey(st.key, part.transposeChromatic, part.preferSharpFlat);
+            break;
+            }
+      json->insert("keysig", int(key));
+
+      if (sc.tempoAmbiguous)
+            *missing << "tempo" << "tempoText";
+      else {
+            json->insert("tempo", sc.tempo);
+            json->insert("tempoText", sc.tempoText);
+            }
+
+      bool partsComplete = true;
+      json->insert("parts", partsJSON(sc, &partsComplete));
+      if (!partsComplete)
+            *missing << "parts";
+
+      QJsonObject jsonPageformat;
+      jsonPageformat.insert("height", round(sc.pageHeight * INCH));
+      jsonPageformat.insert("width", round(sc.pageWidth * INCH));
+      jsonPageformat.insert("twosided", sc.pageTwosided ? "true" : "false");
+      json->insert("pageFormat", jsonPageformat);
+
+      QJsonObject jsonTypeData;
+      jsonTypeData.insert("titles", QJsonArray::fromStringList(sc.frameTexts.value(Tid::TITLE)));
+      jsonTypeData.insert("subtitles", QJsonArray::fromStringList(sc.frameTexts.value(Tid::SUBTITLE)));
+      jsonTypeData.insert("composers", QJsonArray::fromStringList(sc.frameTexts.value(Tid::COMPOSER)));
+      jsonTypeData.insert("poets", QJsonArray::fromStringList(sc.frameTexts.value(Tid::POET)));
+      json->insert("textFramesData", jsonTypeData);
+
+      bool excerptsComplete = true;
+      QJsonArray jsonExcerptsArray;
+      for (int i = 0; i < int(sc.excerpts.size()); ++i) {
+            QJsonObject jsonExcerpt;
+            jsonExcerpt.insert("id", i);
+            jsonExcerpt.insert("title", sc.excerpts[i].name);
+            jsonExcerpt.insert("parts", partsJSON(sc.excerpts[i], &excerptsComplete));
+            jsonExcerptsArray.append(jsonExcerpt);
+            }
+      json->insert("excerpts", jsonExcerptsArray);
+      if (!excerptsComplete)
+            *missing << "excerpts";
+
+      // these need a laid out score or the unrolled repeats
+      *missing << "pages" << "duration" << "lyrics";
+      return true;
+      }
+
+}
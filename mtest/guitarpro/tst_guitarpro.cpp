@@ -245,6 +245,7 @@ private slots:
       void gp4CapoFret()      { gpReadTest("capo-fret", "gp4"); }
       void gp5CapoFret()      { gpReadTest("capo-fret", "gp5"); }
       void gpxUncompletedMeasure() { gpReadTest("UncompletedMeasure", "gpx"); }
+      void benchmarkGpx();
       };
 
 //---------------------------------------------------------
@@ -272,5 +273,23 @@ void TestGuitarPro::gpReadTest(const char* file, const char* ext)
       delete score;
       }
 
+//---------------------------------------------------------
+//   benchmarkGpx
+//    import the largest .gpx files, container decoding
+//    included
+//---------------------------------------------------------
+
+void TestGuitarPro::benchmarkGpx()
+      {
+      preferences.setPreference(PREF_IMPORT_GUITARPRO_CHARSET, "");
+      QBENCHMARK {
+            for (const char* file : { "all-percussion", "fret-diagram_2instruments", "keysig" }) {
+                  MasterScore* score = readScore(DIR + file + ".gpx");
+                  QVERIFY(score);
+                  delete score;
+                  }
+            }
+      }
+
 QTEST_MAIN(TestGuitarPro)
 #include "tst_guitarpro.moc"
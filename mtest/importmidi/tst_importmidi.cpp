@@ -20,6 +20,8 @@
 #include "libmscore/chord.h"
 #include "libmscore/note.h"
 #include "libmscore/keysig.h"
+#include "libmscore/part.h"
+#include "libmscore/staff.h"
 #include "audio/exports/exportmidi.h"
 
 #include "libmscore/mcursor.h"
@@ -56,6 +58,7 @@ class TestImportMidi : public QObject, public MTest
       QString midiFilePath(const QString &fileName) const;
       QString midiFilePath(const char* fileName) const;
       void mf(const char* name) const;
+      void mfLoad(const char* name);
 
                   // functions that modify default settings
       void dontSimplify(const char *file)
@@ -107,6 +110,19 @@ class TestImportMidi : public QObject, public MTest
             data.trackOpers.showTempoText.setDefaultValue(false);
             mf(file);
             }
+      void loadWithoutReload(const char *file)
+            {
+            auto &opers = midiImportOperations;
+            opers.addNewMidiFile(midiFilePath(file));
+            MidiOperations::CurrentMidiFileSetter setCurrentMidiFile(opers, midiFilePath(file));
+            auto &data = *opers.data();
+
+            data.trackOpers.simplifyDurations.setDefaultValue(false, false);
+            data.trackOpers.maxVoiceCount.setDefaultValue(MidiOperations::VoiceCount::V_1, false);
+            data.trackOpers.doStaffSplit.setDefaultValue(false, false);
+            data.trackOpers.showTempoText.setDefaultValue(false);
+            mfLoad(file);
+            }
       void staffSplit(const char *file)
             {
             auto &opers = midiImportOperations;
@@ -295,8 +311,14 @@ class TestImportMidi : public QObject, public MTest
       void tupletOffTimeOtherBar2() { dontSimplify("tuplet_off_time_other_bar2"); }
       void tuplet16th8th() { dontSimplify("tuplet_16th_8th"); }
       void tuplet7Staccato() { noTempoText("tuplet_7_staccato"); }
+      void tupletSearchNotTruncated();
       void minDuration() { dontSimplify("min_duration"); }
 
+      // the web load: normalize and lay out, instead of saving and reloading
+      void loadWithoutReloadM3() { loadWithoutReload("m3"); }
+      void loadWithoutReloadClefTied() { loadWithoutReload("clef_tied"); }
+      void loadWithoutReloadTuplets() { loadWithoutReload("tuplet_triplets_mixed"); }
+
       void pickupMeasure() { dontSimplify("pickup"); }
       void pickupMeasureLong() { noTempoText("pickup_long"); }
       void pickupMeasureTurnOff() { noTempoText("pickup_turn_off"); }
@@ -429,6 +451,46 @@ void TestImportMidi::mf(const char* name) const
       delete score;
       }
 
+//---------------------------------------------------------
+//   mfLoad
+//    import as web/main.cpp _load does: the imported score
+//    is normalized and laid out in place, and must save the
+//    same as the score saved and reloaded from MSCX, the
+//    way it was loaded before
+//---------------------------------------------------------
+
+void TestImportMidi::mfLoad(const char* name)
+      {
+      const QString reference = DIR + name + "_load.mscx";
+
+      MasterScore* score = new MasterScore(mscore->baseStyle());
+      score->setName(name);
+      QCOMPARE(importMidi(score, midiFilePath(name)), Score::FileError::FILE_NO_ERROR);
+      score->connectTies();
+      score->fixTicks();
+      for (Part* p : score->parts())
+            p->updateHarmonyChannels(false);
+      for (Staff* s : score->staves())
+            s->updateOttava();
+      score->setCreated(false);
+      score->doLayout();
+      QVERIFY(saveCompareScore(score, QString(name) + "_load.mscx", reference));
+      delete score;
+
+      score = new MasterScore(mscore->baseStyle());
+      score->setName(name);
+      QCOMPARE(importMidi(score, midiFilePath(name)), Score::FileError::FILE_NO_ERROR);
+      score->connectTies();
+      const QString saved = QString(name) + "_import.mscx";
+      QVERIFY(saveScore(score, saved));
+      delete score;
+
+      score = readCreatedScore(saved);
+      QVERIFY(score);
+      QVERIFY(saveCompareScore(score, QString(name) + "_reload.mscx", reference));
+      delete score;
+      }
+
 QString TestImportMidi::midiFilePath(const QString &fileName) const
       {
       const QString nameWithExtention = fileName + ".mid";
@@ -440,6 +502,33 @@ QString TestImportMidi::midiFilePath(const char* fileName) const
       return midiFilePath(QString(fileName));
       }
 
+//---------------------------------------------------------
+//   tupletSearchNotTruncated
+//    the tuplet search is exhaustive on all test files,
+//    so the node limit does not change the chosen tuplets
+//    compared with the references of the other tests
+//---------------------------------------------------------
+
+void TestImportMidi::tupletSearchNotTruncated()
+      {
+      const QStringList files = QDir(TESTROOT "/mtest/" + DIR).entryList(QStringList("*.mid"), QDir::Files, QDir::Name);
+      QVERIFY(!files.isEmpty());
+      int searchedBars = 0;
+      for (const QString &file: files) {
+            const QString path = midiFilePath(QFileInfo(file).completeBaseName());
+            MasterScore* score = new MasterScore(mscore->baseStyle());
+            QCOMPARE(importMidi(score, path), Score::FileError::FILE_NO_ERROR);
+            delete score;
+
+            auto &opers = midiImportOperations;
+            MidiOperations::CurrentMidiFileSetter setCurrentMidiFile(opers, path);
+            const auto &searchData = opers.data()->tupletSearchData;
+            QVERIFY2(searchData.truncatedBars == 0, qPrintable(file));
+            searchedBars += searchData.searchedBars;
+            }
+      QVERIFY(searchedBars > 0);
+      }
+
 //---------------------------------------------------------
 //  tuplet recognition functions
 //---------------------------------------------------------
@@ -13,6 +13,9 @@
 #include <QtTest/QtTest>
 #include "mtest/testutils.h"
 #include "libmscore/score.h"
+#include "libmscore/measure.h"
+#include "libmscore/segment.h"
+#include "libmscore/shape.h"
 
 #define DIR QString("libmscore/layout/")
 
@@ -39,6 +42,8 @@ class TestBenchmark : public QObject, public MTest
       void benchmark1();
       void benchmark2();
       void benchmark4();            // incremental layout (one page)
+      void benchmark5();            // tick to measure lookups
+      void benchmark6();            // horizontal distance of segment shapes
       };
 
 //---------------------------------------------------------
@@ -89,6 +94,49 @@ void TestBenchmark::benchmark4()
             }
       }
 
+//---------------------------------------------------------
+//   benchmark5
+//    look up every measure and segment of the score by tick
+//---------------------------------------------------------
+
+void TestBenchmark::benchmark5()
+      {
+      for (Measure* m = score->firstMeasure(); m; m = m->nextMeasure()) {
+            QCOMPARE(score->tick2measure(m->tick()), m);
+            QCOMPARE(score->tick2measureBase(m->tick()), static_cast<MeasureBase*>(m));
+            }
+      QBENCHMARK {
+            for (Measure* m = score->firstMeasure(); m; m = m->nextMeasure()) {
+                  score->tick2measure(m->tick() + m->ticks() * Fraction(1,2));
+                  score->tick2measureMM(m->tick());
+                  for (Segment* s = m->first(SegmentType::ChordRest); s; s = s->next(SegmentType::ChordRest))
+                        score->tick2segment(s->tick());
+                  }
+            }
+      }
+
+//---------------------------------------------------------
+//   benchmark6
+//    the distances computed by horizontal spacing, for
+//    every pair of adjacent segments on every staff
+//---------------------------------------------------------
+
+void TestBenchmark::benchmark6()
+      {
+      std::vector<std::pair<const Shape*, const Shape*>> pairs;
+      for (Segment* s = score->firstSegment(SegmentType::All); s; s = s->next1()) {
+            Segment* ns = s->next();
+            if (!ns)
+                  continue;
+            for (int staffIdx = 0; staffIdx < score->nstaves(); ++staffIdx)
+                  pairs.push_back({ &s->staffShape(staffIdx), &ns->staffShape(staffIdx) });
+            }
+      QBENCHMARK {
+            for (const auto& p : pairs)
+                  p.first->minHorizontalDistance(*p.second);
+            }
+      }
+
 QTEST_MAIN(TestBenchmark)
 #include "tst_benchmark.moc"
 
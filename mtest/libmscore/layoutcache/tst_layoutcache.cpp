@@ -0,0 +1,182 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  Copyright (C) 2020 Werner Schweer
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2
+//  as published by the Free Software Foundation and appearing in
+//  the file LICENCE.GPL
+//=============================================================================
+
+#include <QtTest/QtTest>
+
+#include "mtest/testutils.h"
+#include "libmscore/score.h"
+#include "thirdparty/qzip/qzipreader_p.h"
+#include "thirdparty/qzip/qzipwriter_p.h"
+
+#define SCORE QString("libmscore/layout_elements/layout_elements.mscx")
+
+using namespace Ms;
+
+static const QByteArray cache("{\"pages\":1}");
+
+//---------------------------------------------------------
+//   TestLayoutCache
+//---------------------------------------------------------
+
+class TestLayoutCache : public QObject, public MTest
+      {
+      Q_OBJECT
+
+      QByteArray saveMscz(Score* score);
+      MasterScore* loadMscz(const QByteArray& data);
+
+   private slots:
+      void initTestCase();
+      void layoutCacheKept();
+      void layoutCacheScoreChanged();
+      void layoutCacheFileChanged();
+      };
+
+//---------------------------------------------------------
+//   initTestCase
+//---------------------------------------------------------
+
+void TestLayoutCache::initTestCase()
+      {
+      initMTest();
+      }
+
+//---------------------------------------------------------
+//   saveMscz
+//---------------------------------------------------------
+
+QByteArray TestLayoutCache::saveMscz(Score* score)
+      {
+      QBuffer buffer;
+      buffer.open(QIODevice::WriteOnly);
+      if (!score->saveCompressedFile(&buffer, "layoutcache.mscx", false, false))
+            return QByteArray();
+      return buffer.data();
+      }
+
+//---------------------------------------------------------
+//   loadMscz
+//---------------------------------------------------------
+
+MasterScore* TestLayoutCache::loadMscz(const QByteArray& data)
+      {
+      QBuffer buffer;
+      buffer.setData(data);
+      buffer.open(QIODevice::ReadOnly);
+      MasterScore* score = new MasterScore(mscore->baseStyle());
+      if (score->loadMsc("layoutcache.mscz", &buffer, false) != Score::FileError::FILE_NO_ERROR) {
+            delete score;
+            return 0;
+            }
+      return score;
+      }
+
+//---------------------------------------------------------
+//   layoutCacheKept
+//    a cache made for the saved content is read back
+//---------------------------------------------------------
+
+void TestLayoutCache::layoutCacheKept()
+      {
+      MasterScore* score = readScore(SCORE);
+      QVERIFY(score);
+      score->setLayoutCache(cache);
+      const QByteArray data = saveMscz(score);
+      QVERIFY(!data.isEmpty());
+      delete score;
+
+      score = loadMscz(data);
+      QVERIFY(score);
+      QCOMPARE(score->layoutCache(), cache);
+
+      // and saved again with the unchanged score
+      const QByteArray data2 = saveMscz(score);
+      delete score;
+      score = loadMscz(data2);
+      QVERIFY(score);
+      QCOMPARE(score->layoutCache(), cache);
+      delete score;
+      }
+
+//---------------------------------------------------------
+//   layoutCacheScoreChanged
+//    a cache made before the score changed is not saved
+//---------------------------------------------------------
+
+void TestLayoutCache::layoutCacheScoreChanged()
+      {
+      MasterScore* score = readScore(SCORE);
+      QVERIFY(score);
+      score->setLayoutCache(cache);
+      score->setMetaTag("workTitle", "changed after the layout cache was made");
+      const QByteArray data = saveMscz(score);
+      QVERIFY(!data.isEmpty());
+      delete score;
+
+      QBuffer buffer;
+      buffer.setData(data);
+      buffer.open(QIODevice::ReadOnly);
+      MQZipReader uz(&buffer);
+      QVERIFY(uz.fileData("LayoutCache/key").isEmpty());
+      QVERIFY(uz.fileData("LayoutCache/layout.json").isEmpty());
+
+      score = loadMscz(data);
+      QVERIFY(score);
+      QVERIFY(score->layoutCache().isEmpty());
+      delete score;
+      }
+
+//---------------------------------------------------------
+//   layoutCacheFileChanged
+//    a cache is dropped on load if the score in the file
+//    was changed without it
+//---------------------------------------------------------
+
+void TestLayoutCache::layoutCacheFileChanged()
+      {
+      MasterScore* score = readScore(SCORE);
+      QVERIFY(score);
+      score->setLayoutCache(cache);
+      const QByteArray data = saveMscz(score);
+      delete score;
+
+      // copy the file, changing the score but keeping the cache entries
+      QBuffer in;
+      in.setData(data);
+      in.open(QIODevice::ReadOnly);
+      MQZipReader uz(&in);
+      QBuffer out;
+      out.open(QIODevice::WriteOnly);
+      MQZipWriter zw(&out);
+      bool changed = false;
+      for (const MQZipReader::FileInfo& fi : uz.fileInfoList()) {
+            if (!fi.isFile)
+                  continue;
+            QByteArray entry = uz.fileData(fi.filePath);
+            if (fi.filePath.endsWith(".mscx")) {
+                  entry.append("\n");
+                  changed = true;
+                  }
+            zw.addFile(fi.filePath, entry);
+            }
+      zw.close();
+      QVERIFY(changed);
+      QVERIFY(!uz.fileData("LayoutCache/key").isEmpty());
+
+      score = loadMscz(out.data());
+      QVERIFY(score);
+      QVERIFY(score->layoutCache().isEmpty());
+      delete score;
+      }
+
+QTEST_MAIN(TestLayoutCache)
+#include "tst_layoutcache.moc"
@@ -0,0 +1,149 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  Copyright (C) 2020 Werner Schweer
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2
+//  as published by the Free Software Foundation and appearing in
+//  the file LICENCE.GPL
+//=============================================================================
+
+#include <QtTest/QtTest>
+
+#include "mtest/testutils.h"
+#include "libmscore/score.h"
+#include "libmscore/importexports.h"
+
+using namespace Ms;
+
+//---------------------------------------------------------
+//   TestMetadata
+//    scanMetadataJSON() must give the same fields as
+//    saveMetadataJSON() on the loaded score
+//---------------------------------------------------------
+
+class TestMetadata : public QObject, public MTest
+      {
+      Q_OBJECT
+
+      int compared { 0 };
+
+      QStringList files() const;
+      void compare(MasterScore* score, const QByteArray& data, const QString& name);
+
+   private slots:
+      void initTestCase();
+      void scanMscx();
+      void scanMscz();
+      };
+
+//---------------------------------------------------------
+//   initTestCase
+//---------------------------------------------------------
+
+void TestMetadata::initTestCase()
+      {
+      initMTest();
+      }
+
+//---------------------------------------------------------
+//   files
+//    the MSCX fixtures of tests covering the scanned fields
+//---------------------------------------------------------
+
+QStringList TestMetadata::files() const
+      {
+      QStringList l;
+      for (const char* dir : { "chordsymbol", "keysig", "layout_elements", "parts", "spanners", "timesig", "tuplet" }) {
+            const QString path = QString("libmscore/") + dir + "/";
+            for (const QString& file : QDir(root + "/" + path).entryList(QStringList("*.mscx"), QDir::Files, QDir::Name))
+                  l.append(path + file);
+            }
+      return l;
+      }
+
+//---------------------------------------------------------
+//   compare
+//    compare the fields scanned off data with the fields
+//    of score, which was loaded from data
+//---------------------------------------------------------
+
+void TestMetadata::compare(MasterScore* score, const QByteArray& data, const QString& name)
+      {
+      QJsonObject scanned;
+      QStringList missing;
+      if (!scanMetadataJSON(data, name, &scanned, &missing))
+            return;                 // not a 3.x file, it is converted on load
+      const QJsonObject saved = saveMetadataJSON(score);
+      for (const QString& key : scanned.keys()) {
+            QVERIFY2(!missing.contains(key), qPrintable(name + ": " + key + " scanned and missing"));
+            QVERIFY2(saved.contains(key), qPrintable(name + ": " + key + " not saved"));
+            const QJsonValue a = scanned.value(key);
+            const QJsonValue b = saved.value(key);
+            if (a != b) {
+                  auto text = [](const QJsonValue& v) {
+                        QJsonArray wrap;
+                        wrap.append(v);
+                        return QString::fromUtf8(QJsonDocument(wrap).toJson(QJsonDocument::Compact));
+                        };
+                  QFAIL(qPrintable(QString("%1: %2 scanned %3, saved %4").arg(name, key, text(a), text(b))));
+                  }
+            }
+      for (const QString& key : saved.keys())
+            QVERIFY2(scanned.contains(key) || missing.contains(key), qPrintable(name + ": " + key + " neither scanned nor missing"));
+      ++compared;
+      }
+
+//---------------------------------------------------------
+//   scanMscx
+//---------------------------------------------------------
+
+void TestMetadata::scanMscx()
+      {
+      compared = 0;
+      for (const QString& file : files()) {
+            QFile f(root + "/" + file);
+            QVERIFY(f.open(QIODevice::ReadOnly));
+            const QByteArray data = f.readAll();
+            MasterScore* score = readScore(file);
+            QVERIFY2(score, qPrintable(file));
+            compare(score, data, root + "/" + file);
+            delete score;
+            }
+      QVERIFY(compared > 0);
+      }
+
+//---------------------------------------------------------
+//   scanMscz
+//    the same scores saved as MSCZ and loaded again
+//---------------------------------------------------------
+
+void TestMetadata::scanMscz()
+      {
+      compared = 0;
+      for (const QString& file : files()) {
+            MasterScore* score = readScore(file);
+            QVERIFY2(score, qPrintable(file));
+            QBuffer buffer;
+            buffer.open(QIODevice::WriteOnly);
+            const QString name = QFileInfo(file).completeBaseName();
+            QVERIFY(score->saveCompressedFile(&buffer, name + ".mscx", false, false));
+            delete score;
+
+            const QByteArray data = buffer.data();
+            QBuffer in;
+            in.setData(data);
+            in.open(QIODevice::ReadOnly);
+            score = new MasterScore(mscore->baseStyle());
+            score->setName(name);
+            QCOMPARE(score->loadMsc(name + ".mscz", &in, false), Score::FileError::FILE_NO_ERROR);
+            compare(score, data, name + ".mscz");
+            delete score;
+            }
+      QVERIFY(compared > 0);
+      }
+
+QTEST_MAIN(TestMetadata)
+#include "tst_metadata.moc"
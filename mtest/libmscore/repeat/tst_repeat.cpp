@@ -15,6 +15,7 @@
 #include "libmscore/score.h"
 #include "libmscore/measure.h"
 #include "libmscore/repeatlist.h"
+#include "libmscore/tempo.h"
 
 #define DIR QString("libmscore/repeat/")
 
@@ -155,6 +156,22 @@ void TestRepeat::repeat(const char* f1, const QString & ref)
       ref1.replace(" ","");
       qDebug("File <%s> sequence %s", f1, qPrintable(s));
       QCOMPARE(s, ref1);
+
+      // the binary searches of the RepeatList agree with a walk over its segments
+      const RepeatList& rl = score->repeatList();
+      for (const RepeatSegment* rs : rl) {
+            for (int utick = rs->utick; utick < rs->utick + rs->len(); utick += MScore::division / 2) {
+                  int tick = utick - rs->utick + rs->tick;
+                  QCOMPARE(rl.utick2tick(utick), tick);
+                  QCOMPARE(rl.utick2utime(utick), score->tempomap()->tick2time(tick) + rs->timeOffset);
+                  }
+            for (const RepeatSegment* fs : rl) {
+                  if (rs->tick >= fs->tick && rs->tick < fs->tick + fs->len()) {
+                        QCOMPARE(rl.tick2utick(rs->tick), fs->utick + rs->tick - fs->tick);
+                        break;
+                        }
+                  }
+            }
       delete score;
       }
 
@@ -0,0 +1,163 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  Copyright (C) 2020 Werner Schweer
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2
+//  as published by the Free Software Foundation and appearing in
+//  the file LICENCE.GPL
+//=============================================================================
+
+#include <QtTest/QtTest>
+
+#include "mtest/testutils.h"
+#include "libmscore/shape.h"
+
+using namespace Ms;
+
+//---------------------------------------------------------
+//   refMinHorizontalDistance
+//    the former Shape::minHorizontalDistance, comparing
+//    every pair of rectangles; the sweep used for large
+//    shapes must give the same results
+//---------------------------------------------------------
+
+static qreal refMinHorizontalDistance(const Shape& s1, const Shape& s2)
+      {
+      qreal dist = -1000000.0;      // min real
+      for (const QRectF& r2 : s2) {
+            qreal by1 = r2.top();
+            qreal by2 = r2.bottom();
+            for (const QRectF& r1 : s1) {
+                  qreal ay1 = r1.top();
+                  qreal ay2 = r1.bottom();
+                  if (Ms::intersects(ay1, ay2, by1, by2)
+                     || ((r1.height() == 0.0) && (r2.height() == 0.0) && (ay1 == by1))
+                     || ((r1.width() == 0.0) || (r2.width() == 0.0)))
+                        dist = qMax(dist, r1.right() - r2.left());
+                  }
+            }
+      return dist;
+      }
+
+//---------------------------------------------------------
+//   TestShape
+//---------------------------------------------------------
+
+class TestShape : public QObject, public MTest
+      {
+      Q_OBJECT
+
+      Shape randomShape(int n, qreal x) const;
+
+   private slots:
+      void initTestCase();
+      void minHorizontalDistanceRandom();
+      void minHorizontalDistanceEdges();
+      };
+
+//---------------------------------------------------------
+//   initTestCase
+//---------------------------------------------------------
+
+void TestShape::initTestCase()
+      {
+      initMTest();
+      }
+
+//---------------------------------------------------------
+//   randomShape
+//    n rectangles around x, on a coarse grid so that many
+//    of them touch or share their top; some have zero width,
+//    zero height or negative height
+//---------------------------------------------------------
+
+Shape TestShape::randomShape(int n, qreal x) const
+      {
+      auto grid = [](int steps) { return 0.5 * (qrand() % steps); };
+      Shape s;
+      for (int i = 0; i < n; ++i) {
+            qreal w = grid(12);
+            qreal h = grid(12);
+            switch (qrand() % 8) {
+                  case 0: w = 0.0; break;
+                  case 1: h = 0.0; break;
+                  case 2: h = -h;  break;
+                  default:         break;
+                  }
+            s.add(QRectF(x + grid(20) - 5.0, grid(40) - 10.0, w, h));
+            }
+      return s;
+      }
+
+//---------------------------------------------------------
+//   minHorizontalDistanceRandom
+//    shape sizes below, at and above the 64 pairs from
+//    which the sweep is used
+//---------------------------------------------------------
+
+void TestShape::minHorizontalDistanceRandom()
+      {
+      qsrand(4711);
+      const std::vector<std::pair<int, int>> sizes {
+            { 1, 1 }, { 1, 64 }, { 8, 8 }, { 1, 65 }, { 65, 1 }, { 8, 9 },
+            { 9, 8 }, { 16, 16 }, { 3, 50 }, { 64, 64 }, { 200, 150 }
+            };
+      for (const auto& size : sizes) {
+            for (int pass = 0; pass < 500; ++pass) {
+                  const Shape s1 = randomShape(size.first, 0.0);
+                  const Shape s2 = randomShape(size.second, 5.0);
+                  const QString where = QString("%1x%2 pass %3").arg(size.first).arg(size.second).arg(pass);
+                  QVERIFY2(s1.minHorizontalDistance(s2) == refMinHorizontalDistance(s1, s2), qPrintable(where));
+                  QVERIFY2(s2.minHorizontalDistance(s1) == refMinHorizontalDistance(s2, s1), qPrintable(where));
+                  }
+            }
+      }
+
+//---------------------------------------------------------
+//   minHorizontalDistanceEdges
+//    each special rectangle in a shape large enough for
+//    the sweep, against rectangles touching it, sharing its
+//    top or bottom, or overlapping it
+//---------------------------------------------------------
+
+void TestShape::minHorizontalDistanceEdges()
+      {
+      const std::vector<QRectF> special {
+            QRectF(0.0, 0.0, 0.0, 2.0),         // zero width
+            QRectF(0.0, 0.0, 0.0, 0.0),         // point
+            QRectF(0.0, 1.0, 3.0, 0.0),         // zero height
+            QRectF(0.0, 2.0, 3.0, -2.0),        // negative height
+            QRectF(0.0, 0.0, 3.0, 2.0),
+            };
+      const std::vector<QRectF> others {
+            QRectF(2.0, 2.0, 1.0, 1.0),         // touching below
+            QRectF(2.0, -1.0, 1.0, 1.0),        // touching above
+            QRectF(3.0, 0.0, 1.0, 2.0),         // touching right
+            QRectF(1.0, 1.0, 2.0, 0.0),         // zero height at the same y
+            QRectF(1.0, 2.0, 2.0, 0.0),         // zero height on the bottom
+            QRectF(1.0, 0.5, 0.0, 1.0),         // zero width
+            QRectF(1.0, 1.5, 2.0, -1.0),        // negative height
+            QRectF(1.0, 0.5, 2.0, 1.0),         // overlapping
+            };
+      for (const QRectF& r1 : special) {
+            for (const QRectF& r2 : others) {
+                  for (int n : { 1, 8, 9, 40 }) {
+                        Shape s1, s2;
+                        for (int i = 0; i < n; ++i) {
+                              s1.add(r1.translated(0.0, 10.0 * i));
+                              s2.add(r2.translated(0.0, 10.0 * i + (i % 2 ? 0.0 : 5.0)));
+                              }
+                        s1.add(r1);
+                        s2.add(r2);
+                        QCOMPARE(s1.minHorizontalDistance(s2), refMinHorizontalDistance(s1, s2));
+                        QCOMPARE(s2.minHorizontalDistance(s1), refMinHorizontalDistance(s2, s1));
+                        }
+                  }
+            }
+      }
+
+QTEST_MAIN(TestShape)
+#include "tst_shape.moc"
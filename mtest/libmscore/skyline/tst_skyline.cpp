@@ -0,0 +1,303 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  Copyright (C) 2018 Werner Schweer
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2
+//  as published by the Free Software Foundation and appearing in
+//  the file LICENCE.GPL
+//=============================================================================
+
+#include <QtTest/QtTest>
+
+#include "mtest/testutils.h"
+#include "libmscore/score.h"
+#include "libmscore/measure.h"
+#include "libmscore/segment.h"
+#include "libmscore/shape.h"
+#include "libmscore/skyline.h"
+#include "libmscore/spanner.h"
+#include "libmscore/system.h"
+
+using namespace Ms;
+
+//---------------------------------------------------------
+//   RefSkylineLine
+//    the former SkylineLine, one std::vector of segments;
+//    SkylineLine must give the same results
+//---------------------------------------------------------
+
+class RefSkylineLine {
+      const bool north;
+      std::vector<SkylineSegment> seg;
+      typedef std::vector<SkylineSegment>::iterator SegIter;
+
+      SegIter insert(SegIter i, qreal x, qreal y, qreal w) {
+            const qreal xr = x + w;
+            if (i != seg.end() && xr > i->x)
+                  i->x = xr;
+            return seg.emplace(i, x, y, w);
+            }
+      SegIter find(qreal x) {
+            auto it = std::upper_bound(seg.begin(), seg.end(), x, [](qreal x, const SkylineSegment& s) { return x < s.x; });
+            if (it == seg.begin())
+                  return it;
+            return (--it);
+            }
+
+   public:
+      RefSkylineLine(bool n) : north(n) {}
+      void add(const Shape& s) {
+            for (const QRectF& r : s)
+                  add(north ? r.top() : r.bottom(), r);
+            }
+      void add(qreal y, const QRectF& r);
+      qreal minDistance(const RefSkylineLine&) const;
+      qreal max() const;
+      const std::vector<SkylineSegment>& segments() const { return seg; }
+      };
+
+void RefSkylineLine::add(qreal y, const QRectF& r)
+      {
+      qreal x = r.x();
+      qreal w = r.width();
+      if (x < 0.0) {
+            w -= -x;
+            x = 0.0;
+            if (w <= 0.0)
+                  return;
+            }
+      SegIter i = find(x);
+      qreal cx = seg.empty() ? 0.0 : i->x;
+      for (; i != seg.end(); ++i) {
+            qreal cy = i->y;
+            if ((x + w) <= cx)
+                  return;
+            if (x > (cx + i->w)) {
+                  cx += i->w;
+                  continue;
+                  }
+            if ((north && (cy <= y)) || (!north && (cy >= y))) {
+                  cx += i->w;
+                  continue;
+                  }
+            if ((x >= cx) && ((x+w) < (cx+i->w))) {
+                  qreal w1 = x - cx;
+                  qreal w2 = w;
+                  qreal w3 = i->w - (w1 + w2);
+                  if (w1 > 0.0000001) {
+                        i->w = w1;
+                        ++i;
+                        i = insert(i, x, y, w2);
+                        }
+                  else {
+                        i->w = w2;
+                        i->y = y;
+                        }
+                  if (w3 > 0.0000001) {
+                        ++i;
+                        insert(i, x + w2, cy, w3);
+                        }
+                  return;
+                  }
+            else if ((x <= cx) && ((x + w) >= (cx + i->w)))
+                  i->y = y;
+            else if (x < cx) {
+                  qreal w1 = x + w - cx;
+                  i->w    -= w1;
+                  insert(i, cx, y, w1);
+                  return;
+                  }
+            else {
+                  qreal w1 = x - cx;
+                  qreal w2 = i->w - w1;
+                  if (w2 > 0.0000001) {
+                        i->w = w1;
+                        cx  += w1;
+                        ++i;
+                        i = insert(i, cx, y, w2);
+                        }
+                  }
+            cx += i->w;
+            }
+      if (x >= cx) {
+            if (x > cx)
+                  seg.emplace_back(cx, north ? 1000000.0 : -1000000.0, x - cx);
+            seg.emplace_back(x, y, w);
+            }
+      else if (x + w > cx)
+            seg.emplace_back(cx, y, x + w - cx);
+      }
+
+qreal RefSkylineLine::minDistance(const RefSkylineLine& sl) const
+      {
+      qreal dist = -1000000.0;
+      qreal x1 = 0.0;
+      qreal x2 = 0.0;
+      auto k   = sl.seg.begin();
+      for (auto i = seg.begin(); i != seg.end(); ++i) {
+            while (k != sl.seg.end() && (x2 + k->w) < x1) {
+                  x2 += k->w;
+                  ++k;
+                  }
+            if (k == sl.seg.end())
+                  break;
+            for (;;) {
+                  if ((x1 + i->w > x2) && (x1 < x2 + k->w))
+                        dist = qMax(dist, i->y - k->y);
+                  if (x2 + k->w < x1 + i->w) {
+                        x2 += k->w;
+                        ++k;
+                        if (k == sl.seg.end())
+                              break;
+                        }
+                  else
+                        break;
+                  }
+            if (k == sl.seg.end())
+                  break;
+            x1 += i->w;
+            }
+      return dist;
+      }
+
+qreal RefSkylineLine::max() const
+      {
+      qreal val = north ? 1000000.0 : -1000000.0;
+      for (const SkylineSegment& s : seg)
+            val = north ? qMin(val, s.y) : qMax(val, s.y);
+      return val;
+      }
+
+//---------------------------------------------------------
+//   TestSkyline
+//---------------------------------------------------------
+
+class TestSkyline : public QObject, public MTest
+      {
+      Q_OBJECT
+
+      void compare(const SkylineLine& a, const RefSkylineLine& b, const QString& where);
+
+   private slots:
+      void initTestCase();
+      void skylineRandom();
+      void skylineVtest();
+      };
+
+//---------------------------------------------------------
+//   initTestCase
+//---------------------------------------------------------
+
+void TestSkyline::initTestCase()
+      {
+      initMTest();
+      }
+
+//---------------------------------------------------------
+//   compare
+//---------------------------------------------------------
+
+void TestSkyline::compare(const SkylineLine& a, const RefSkylineLine& b, const QString& where)
+      {
+      QCOMPARE(a.max(), b.max());
+      auto k = b.segments().begin();
+      for (const SkylineSegment& s : a) {
+            QVERIFY2(k != b.segments().end(), qPrintable(where));
+            QVERIFY2(s.x == k->x && s.y == k->y && s.w == k->w, qPrintable(where));
+            ++k;
+            }
+      QVERIFY2(k == b.segments().end(), qPrintable(where));
+      }
+
+//---------------------------------------------------------
+//   skylineRandom
+//    dense lines of random rectangles, many of them
+//    splitting segments in the middle of the line
+//---------------------------------------------------------
+
+void TestSkyline::skylineRandom()
+      {
+      qsrand(4711);
+      auto rnd = [](qreal max) { return max * qrand() / RAND_MAX; };
+      for (int n : { 10, 100, 1000, 5000 }) {
+            for (int pass = 0; pass < 10; ++pass) {
+                  SkylineLine north(true), south(false);
+                  RefSkylineLine refNorth(true), refSouth(false);
+                  Shape sn, ss;
+                  const qreal width = rnd(n * 4.0) + 1.0;
+                  for (int i = 0; i < n; ++i) {
+                        QRectF r(rnd(width) - 5.0, rnd(40.0) - 20.0, (qrand() % 8) ? rnd(20.0) : 0.0, rnd(10.0));
+                        if (qrand() % 5 == 0)
+                              r.moveLeft(qRound(r.x()));
+                        (qrand() % 2 ? sn : ss).add(r);
+                        }
+                  north.add(sn);
+                  refNorth.add(sn);
+                  south.add(ss);
+                  refSouth.add(ss);
+                  const QString where = QString("n %1 pass %2").arg(n).arg(pass);
+                  compare(north, refNorth, where);
+                  compare(south, refSouth, where);
+                  QCOMPARE(south.minDistance(north), refSouth.minDistance(refNorth));
+                  }
+            }
+      }
+
+//---------------------------------------------------------
+//   skylineVtest
+//    rebuild the skylines of all systems of the vtest
+//    scores from their segment and spanner shapes
+//---------------------------------------------------------
+
+void TestSkyline::skylineVtest()
+      {
+      QDir dir(root + "/../vtest");
+      const QStringList files = dir.entryList(QStringList("*.mscx"), QDir::Files, QDir::Name);
+      QVERIFY(!files.isEmpty());
+      for (const QString& file : files) {
+            MasterScore* score = readScore("../vtest/" + file);
+            if (!score)
+                  continue;
+            for (System* system : score->systems()) {
+                  std::vector<SkylineLine> norths, souths;
+                  std::vector<RefSkylineLine> refNorths, refSouths;
+                  for (int staffIdx = 0; staffIdx < score->nstaves(); ++staffIdx) {
+                        SkylineLine north(true), south(false);
+                        RefSkylineLine refNorth(true), refSouth(false);
+                        auto add = [&](const Shape& sh) {
+                              north.add(sh);
+                              south.add(sh);
+                              refNorth.add(sh);
+                              refSouth.add(sh);
+                              };
+                        for (MeasureBase* mb : system->measures()) {
+                              if (!mb->isMeasure())
+                                    continue;
+                              Measure* m = toMeasure(mb);
+                              for (Segment& s : m->segments())
+                                    add(s.staffShape(staffIdx).translated(s.pos() + m->pos()));
+                              }
+                        for (SpannerSegment* ss : system->spannerSegments()) {
+                              if (ss->staffIdx() == staffIdx)
+                                    add(ss->shape().translated(ss->pos()));
+                              }
+                        const QString where = QString("%1 staff %2").arg(file).arg(staffIdx);
+                        compare(north, refNorth, where);
+                        compare(south, refSouth, where);
+                        norths.push_back(north);
+                        souths.push_back(south);
+                        refNorths.push_back(refNorth);
+                        refSouths.push_back(refSouth);
+                        }
+                  for (size_t i = 1; i < norths.size(); ++i)
+                        QCOMPARE(souths[i-1].minDistance(norths[i]), refSouths[i-1].minDistance(refNorths[i]));
+                  }
+            delete score;
+            }
+      }
+
+QTEST_MAIN(TestSkyline)
+#include "tst_skyline.moc"
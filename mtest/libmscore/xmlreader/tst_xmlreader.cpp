@@ -0,0 +1,159 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2
+//  as published by the Free Software Foundation and appearing in
+//  the file LICENCE.GPL
+//=============================================================================
+
+#include <QtTest/QtTest>
+
+#include "libmscore/score.h"
+#include "libmscore/xml.h"
+#include "mtest/testutils.h"
+
+using namespace Ms;
+
+//---------------------------------------------------------
+//   TestXmlReader
+//---------------------------------------------------------
+
+class TestXmlReader : public QObject, public MTest
+      {
+      Q_OBJECT
+
+   private slots:
+      void initTestCase() { initMTest(); }
+      void tags();
+      void numbers();
+      void fractions();
+      void attributes();
+      void benchmarkRead_data();
+      void benchmarkRead();
+      };
+
+//---------------------------------------------------------
+//   tags
+//---------------------------------------------------------
+
+void TestXmlReader::tags()
+      {
+      XmlReader e(QByteArray("<a><Chord/><Note/><grace8after/><sizeIsSpatiumDependent/><chord/><NoSuchTag/></a>"));
+      e.readNextStartElement();
+      QCOMPARE(e.tag(), XmlTag::UNKNOWN);
+      const XmlTag expected[] = { XmlTag::CHORD, XmlTag::NOTE, XmlTag::GRACE8_AFTER,
+                                  XmlTag::SIZE_IS_SPATIUM_DEPENDENT, XmlTag::UNKNOWN, XmlTag::UNKNOWN };
+      for (XmlTag t : expected) {
+            QVERIFY(e.readNextStartElement());
+            QCOMPARE(e.tag(), t);
+            e.skipCurrentElement();
+            }
+      QVERIFY(!e.readNextStartElement());
+      }
+
+//---------------------------------------------------------
+//   numbers
+//    the value readers must leave the reader at the end tag
+//    of the value, whatever the element contains
+//---------------------------------------------------------
+
+void TestXmlReader::numbers()
+      {
+      XmlReader e(QByteArray("<a><i>42</i><e></e><x>ff</x><d>-1.5</d><l>12345678901</l>"
+                             "<c><!-- c -->7</c><n>8<b/></n><bad>z</bad><last>1</last></a>"));
+      e.readNextStartElement();
+      bool ok;
+
+      QVERIFY(e.readNextStartElement());
+      QCOMPARE(e.readInt(&ok), 42);
+      QVERIFY(ok);
+      QVERIFY(e.readNextStartElement());
+      QCOMPARE(e.readInt(&ok), 0);
+      QVERIFY(!ok);
+      QVERIFY(e.readNextStartElement());
+      QCOMPARE(e.readIntHex(), 255);
+      QVERIFY(e.readNextStartElement());
+      QCOMPARE(e.readDouble(), -1.5);
+      QVERIFY(e.readNextStartElement());
+      QCOMPARE(e.readLongLong(), 12345678901LL);
+      QVERIFY(e.readNextStartElement());
+      QCOMPARE(e.readInt(), 7);
+      QVERIFY(e.readNextStartElement());
+      QCOMPARE(e.readInt(), 8);
+      QVERIFY(e.readNextStartElement());
+      QCOMPARE(e.readInt(&ok), 0);
+      QVERIFY(!ok);
+      QVERIFY(e.readNextStartElement());
+      QCOMPARE(e.name().toString(), QString("last"));
+      QCOMPARE(e.readInt(), 1);
+      QVERIFY(!e.readNextStartElement());
+      QVERIFY(!e.hasError());
+      }
+
+//---------------------------------------------------------
+//   fractions
+//---------------------------------------------------------
+
+void TestXmlReader::fractions()
+      {
+      XmlReader e(QByteArray("<a><f>3/8</f><f z=\"2\" n=\"4\"/><f>480</f></a>"));
+      e.readNextStartElement();
+      QVERIFY(e.readNextStartElement());
+      QCOMPARE(e.readFraction(), Fraction(3, 8));
+      QVERIFY(e.readNextStartElement());
+      QCOMPARE(e.readFraction(), Fraction(2, 4));
+      QVERIFY(e.readNextStartElement());
+      QCOMPARE(e.readFraction(), Fraction::fromTicks(480));
+      QVERIFY(!e.readNextStartElement());
+      }
+
+//---------------------------------------------------------
+//   attributes
+//---------------------------------------------------------
+
+void TestXmlReader::attributes()
+      {
+      XmlReader e(QByteArray("<a i=\"3\" d=\"0.25\" s=\"text\" empty=\"\"/>"));
+      e.readNextStartElement();
+      QCOMPARE(e.intAttribute("i"), 3);
+      QCOMPARE(e.intAttribute("i", 7), 3);
+      QCOMPARE(e.intAttribute("missing", 7), 7);
+      QCOMPARE(e.intAttribute("empty", 7), 0);
+      QCOMPARE(e.doubleAttribute("d"), 0.25);
+      QCOMPARE(e.doubleAttribute("missing", 1.5), 1.5);
+      QCOMPARE(e.attribute("s"), QString("text"));
+      QCOMPARE(e.attribute("missing", "x"), QString("x"));
+      QVERIFY(e.hasAttribute("empty"));
+      QVERIFY(!e.hasAttribute("missing"));
+      }
+
+//---------------------------------------------------------
+//   benchmarkRead
+//    MSCX parse time of scores from the test corpus
+//---------------------------------------------------------
+
+void TestXmlReader::benchmarkRead_data()
+      {
+      QTest::addColumn<QString>("file");
+      QTest::newRow("moonlight")       << "libmscore/layout_elements/moonlight.mscx";
+      QTest::newRow("layout_elements") << "libmscore/layout_elements/layout_elements.mscx";
+      QTest::newRow("tablature")       << "libmscore/layout_elements/layout_elements_tab.mscx";
+      }
+
+void TestXmlReader::benchmarkRead()
+      {
+      QFETCH(QString, file);
+      const QString path = root + "/" + file;
+      MScore::testMode = true;
+      QBENCHMARK {
+            MasterScore* score = new MasterScore(mscore->baseStyle());
+            score->setName(path);
+            QCOMPARE(score->loadMsc(path, false), Score::FileError::FILE_NO_ERROR);
+            delete score;
+            }
+      }
+
+QTEST_MAIN(TestXmlReader)
+#include "tst_xmlreader.moc"
@@ -42,6 +42,7 @@
 
 #include "qzipreader_p.h"
 #include "qzipwriter_p.h"
+#include <QtCore/qbuffer.h>
 
 #include <zlib.h>
 
@@ -924,25 +925,30 @@ MQZipReader::FileInfo MQZipReader::entryInfoAt(int index) const
 }
 
 /*!
-    Fetch the file contents from the zip archive and return the uncompressed bytes.
+    Locate \a fileName in the archive and fill \a stored with its bytes as
+    they are kept in the archive. If \a view is true and the archive is
+    read from a QBuffer, the data points into the buffer instead of being
+    copied and is only valid as long as the buffer is.
 */
-QByteArray MQZipReader::fileData(const QString &fileName) const
+static bool readStoredData(MQZipReaderPrivate *d, const QString &fileName, bool view,
+                           MQZipReader::StoredData *stored)
 {
     d->scanFiles();
+    const QByteArray name = fileName.toUtf8();
     int i;
     for (i = 0; i < d->fileHeaders.size(); ++i) {
-        if (QString::fromUtf8(d->fileHeaders.at(i).file_name) == fileName)
+        if (d->fileHeaders.at(i).file_name == name)
             break;
     }
     if (i == d->fileHeaders.size())
-        return QByteArray();
+        return false;
 
-    FileHeader header = d->fileHeaders.at(i);
+    const FileHeader &header = d->fileHeaders.at(i);
 
     ushort version_needed = readUShort(header.h.version_needed);
     if (version_needed > ZIP_VERSION) {
         qWarning("QZip: .ZIP specification version %d implementationis needed to extract the data.", version_needed);
-        return QByteArray();
+        return false;
     }
 
     ushort general_purpose_bits = readUShort(header.h.general_purpose_bits);
@@ -955,26 +961,74 @@ QByteArray MQZipReader::fileData(const QString &fileName) const
     LocalFileHeader lh;
     d->device->read((char *)&lh, sizeof(LocalFileHeader));
     uint skip = readUShort(lh.file_name_length) + readUShort(lh.extra_field_length);
-    d->device->seek(d->device->pos() + skip);
-
-    int compression_method = readUShort(lh.compression_method);
-    //qDebug("file=%s: compressed_size=%d, uncompressed_size=%d", fileName.toLocal8Bit().data(), compressed_size, uncompressed_size);
+    qint64 pos = d->device->pos() + skip;
 
     if ((general_purpose_bits & Encrypted) != 0) {
         qWarning("QZip: Unsupported encryption method is needed to extract the data.");
-        return QByteArray();
+        return false;
+    }
+
+    stored->compressionMethod = readUShort(lh.compression_method);
+    stored->uncompressedSize = uncompressed_size;
+    //qDebug("file=%s: compressed_size=%d, uncompressed_size=%d", fileName.toLocal8Bit().data(), compressed_size, uncompressed_size);
+
+    QBuffer *buffer = view ? qobject_cast<QBuffer*>(d->device) : 0;
+    if (buffer) {
+        const QByteArray &all = buffer->data();
+        int size = qBound(qint64(0), all.size() - pos, qint64(compressed_size));
+        stored->data = QByteArray::fromRawData(all.constData() + pos, size);
+    } else {
+        //qDebug("file at %lld", pos);
+        d->device->seek(pos);
+        stored->data = d->device->read(compressed_size);
     }
+    return true;
+}
+
+/*!
+    Fetch the file contents from the zip archive and return the uncompressed bytes.
+*/
+QByteArray MQZipReader::fileData(const QString &fileName) const
+{
+    StoredData stored;
+    if (!readStoredData(d, fileName, true, &stored))
+        return QByteArray();
+    QByteArray data = uncompress(stored);
+    if (data.constData() == stored.data.constData())
+        data = QByteArray(data.constData(), data.size());   // detach from the device buffer
+    return data;
+}
+
+/*!
+    Fetch the file contents from the zip archive without inflating them.
+    The returned data owns its bytes, so it stays valid after the reader
+    and its device are gone. Use uncompress() to get the file contents.
+    Returns an invalid StoredData if the file cannot be read.
+*/
+MQZipReader::StoredData MQZipReader::storedFileData(const QString &fileName) const
+{
+    StoredData stored;
+    if (!readStoredData(d, fileName, false, &stored))
+        return StoredData();
+    return stored;
+}
+
+/*!
+    Return the uncompressed bytes of an entry fetched with storedFileData().
+*/
+QByteArray MQZipReader::uncompress(const StoredData &stored)
+{
+    const QByteArray &compressed = stored.data;
+    const int compressed_size = compressed.size();
+    const int uncompressed_size = stored.uncompressedSize;
+    const int compression_method = stored.compressionMethod;
 
-    //qDebug("file at %lld", d->device->pos());
-    QByteArray compressed = d->device->read(compressed_size);
     if (compression_method == CompressionMethodStored) {
         // no compression
-        compressed.truncate(uncompressed_size);
-        return compressed;
+        return compressed.left(uncompressed_size);
     } else if (compression_method == CompressionMethodDeflated) {
         // Deflate
         //qDebug("compressed=%d", compressed.size());
-        compressed.truncate(compressed_size);
         QByteArray baunzip;
         ulong len = qMax(uncompressed_size,  1);
         int res;
@@ -1002,7 +1056,8 @@ QByteArray MQZipReader::fileData(const QString &fileName) const
         return baunzip;
     }
 
-    qWarning("QZip: Unsupported compression method %d is needed to extract the data.", compression_method);
+    if (compression_method >= 0)
+        qWarning("QZip: Unsupported compression method %d is needed to extract the data.", compression_method);
     return QByteArray();
 }
 
@@ -99,6 +99,22 @@ public:
 
     FileInfo entryInfoAt(int index) const;
     QByteArray fileData(const QString &fileName) const;
+
+    struct StoredData
+    {
+        StoredData() Q_DECL_NOTHROW
+            : compressionMethod(-1), uncompressedSize(0)
+        {}
+
+        bool isValid() const Q_DECL_NOTHROW { return compressionMethod >= 0; }
+
+        QByteArray data;            // the entry as kept in the archive
+        int compressionMethod;
+        int uncompressedSize;
+    };
+
+    StoredData storedFileData(const QString &fileName) const;
+    static QByteArray uncompress(const StoredData &stored);
     bool extractAll(const QString &destinationDir) const;
 
     enum Status {
@@ -75,9 +75,11 @@ class WebMscore {
      * @param {Uint8Array} data 
      * @param {Uint8Array[] | Promise<Uint8Array[]>} fonts load extra font files (CJK characters support)
      * @param {boolean} doLayout set to false if you only need the score metadata or the midi file (Super Fast, 3x faster than the musescore software)
+     * @param {number} layoutMode the layout mode to lay the score out in: `0` page (default), `1` float, `2` line (continuous view), `3` system,
+     *                            or `-1` to keep the mode the score was saved in
      * @returns {Promise<WebMscore>}
      */
-    static async load(format, data, fonts = [], doLayout = true) {
+    static async load(format, data, fonts = [], doLayout = true, layoutMode = 0) {
         const [_fonts] = await Promise.all([
             fonts,
             WebMscore.ready
@@ -93,8 +95,8 @@ class WebMscore {
         // get the pointer to the MasterScore class instance in C
         const scoreptr = Module.ccall('load',  // name of C function
             'number',  // return type
-            ['number', 'number', 'number', 'boolean'],  // argument types
-            [fileformatptr, dataptr, data.byteLength, doLayout]  // arguments
+            ['number', 'number', 'number', 'boolean', 'number'],  // argument types
+            [fileformatptr, dataptr, data.byteLength, doLayout, layoutMode]  // arguments
         )
 
         freePtr(fileformatptr)
@@ -105,17 +107,39 @@ class WebMscore {
             throw new FileError(scoreptr)
         }
 
-        const mscore = new WebMscore(scoreptr)
+        return new WebMscore(scoreptr)
+    }
 
-        // temporary workaround for rendering pdf/images from a midi file
-        if (format === 'midi' || format === 'kar') {
-            // reload from a mscx file
-            const buf = await mscore.saveMsc('mscx')
-            mscore.destroy(true)
-            return WebMscore.load('mscx', buf, [], doLayout)
-        }
+    /**
+     * Get the score metadata without loading the score (MSCZ/MSCX files only)
+     * 
+     * Fields that can only be computed on a loaded score (`pages`, `duration`, `lyrics`, ...) are left out,
+     * unless `full` is set. Other file formats are always loaded.
+     * @param {import('../schemas').InputFileFormat} format 
+     * @param {Uint8Array} data 
+     * @param {boolean} full fill in the remaining fields by loading the score (without layout)
+     * @returns {Promise<Partial<import('../schemas').ScoreMetadata>>}
+     */
+    static async scanMetadata(format, data, full = false) {
+        await WebMscore.ready
+
+        const fileformatptr = getStrPtr(format)
+        const dataptr = getTypedArrayPtr(data)
+
+        const resultptr = Module.ccall('scanMetadata',
+            'number',
+            ['number', 'number', 'number', 'boolean'],
+            [fileformatptr, dataptr, data.byteLength, full]
+        )
+
+        freePtr(fileformatptr)
+        freePtr(dataptr)
+
+        // JSON is plain text
+        const result = Module.UTF8ToString(resultptr + 8)  // 8 bytes of padding
+        freePtr(resultptr)
 
-        return mscore
+        return JSON.parse(result)
     }
 
     /**
@@ -286,10 +310,11 @@ class WebMscore {
     /**
      * Save part score as MSCZ/MSCX file
      * @param {'mscz' | 'mscx'} format 
+     * @param {boolean} layoutCache save the page count and positions in the MSCZ file, so loading it again needs no layout for them
      * @returns {Promise<Uint8Array>}
      */
-    async saveMsc(format = 'mscz') {
-        const dataptr = Module.ccall('saveMsc', 'number', ['number', 'boolean', 'number'], [this.scoreptr, format == 'mscz', this.excerptId])
+    async saveMsc(format = 'mscz', layoutCache = false) {
+        const dataptr = Module.ccall('saveMsc', 'number', ['number', 'boolean', 'number', 'boolean'], [this.scoreptr, format == 'mscz', this.excerptId, layoutCache])
         return readData(dataptr)
     }
 
@@ -538,6 +563,20 @@ class WebMscore {
         return data
     }
 
+    /**
+     * Export the time the layout spent in its phases so far, with the slowest measures and systems, as JSON
+     * @returns {Promise<string>}
+     */
+    async saveLayoutProfile() {
+        const dataptr = Module.ccall('saveLayoutProfile', 'number', ['number', 'number'], [this.scoreptr, this.excerptId])
+
+        // JSON is plain text
+        const data = Module.UTF8ToString(dataptr + 8)  // 8 bytes of padding
+        freePtr(dataptr)
+
+        return data
+    }
+
     /**
      * @param {boolean=} soft (default `true`)
      *                 * `true`  destroy the score instance only, or
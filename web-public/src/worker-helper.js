@@ -71,22 +71,44 @@ class WebMscoreW {
      * @param {Uint8Array} data 
      * @param {Uint8Array[] | Promise<Uint8Array[]>} fonts load extra font files (CJK characters support)
      * @param {boolean} doLayout set to false if you only need the score metadata or the midi file (Super Fast, 3x faster than the musescore software)
+     * @param {number} layoutMode the layout mode to lay the score out in: `0` page (default), `1` float, `2` line (continuous view), `3` system,
+     *                            or `-1` to keep the mode the score was saved in
      */
-    static async load(format, data, fonts = [], doLayout = true) {
+    static async load(format, data, fonts = [], doLayout = true, layoutMode = 0) {
         const instance = new WebMscoreW()
         const [_fonts] = await Promise.all([
             fonts,
             instance.rpc('ready')
         ])
-        await instance.rpc('load', [format, data, _fonts, doLayout], [data.buffer, ..._fonts.map(f => f.buffer)])
+        await instance.rpc('load', [format, data, _fonts, doLayout, layoutMode], [data.buffer, ..._fonts.map(f => f.buffer)])
         return instance
     }
 
+    /**
+     * Get the score metadata without loading the score (MSCZ/MSCX files only)
+     * 
+     * Fields that can only be computed on a loaded score (`pages`, `duration`, `lyrics`, ...) are left out,
+     * unless `full` is set. Other file formats are always loaded.
+     * @param {import('../schemas').InputFileFormat} format 
+     * @param {Uint8Array} data 
+     * @param {boolean} full fill in the remaining fields by loading the score (without layout)
+     * @returns {Promise<Partial<import('../schemas').ScoreMetadata>>}
+     */
+    static async scanMetadata(format, data, full = false) {
+        const instance = new WebMscoreW()
+        try {
+            await instance.rpc('ready')
+            return await instance.rpc('scanMetadata', [format, data, full], [data.buffer])
+        } finally {
+            instance.destroy(false)
+        }
+    }
+
     /**
      * Communicate with the worker thread with JSON-RPC
      * @private
      * @typedef {{ id: number; result?: any; error?: any; }} RPCRes
-     * @param {keyof import('./index').default | '_synthAudio' | 'processSynth' | 'processSynthBatch' | 'load' | 'ready'} method 
+     * @param {keyof import('./index').default | '_synthAudio' | 'processSynth' | 'processSynthBatch' | 'load' | 'scanMetadata' | 'ready'} method 
      * @param {any[]} params 
      * @param {Transferable[]} transfer
      */
@@ -204,10 +226,11 @@ class WebMscoreW {
     /**
      * Save part score as MSCZ/MSCX file
      * @param {'mscz' | 'mscx'} format 
+     * @param {boolean} layoutCache save the page count and positions in the MSCZ file, so loading it again needs no layout for them
      * @returns {Promise<Uint8Array>}
      */
-    async saveMsc(format = 'mscz') {
-        return this.rpc('saveMsc', [format])
+    async saveMsc(format = 'mscz', layoutCache = false) {
+        return this.rpc('saveMsc', [format, layoutCache])
     }
 
     /**
@@ -310,6 +333,14 @@ class WebMscoreW {
         return this.rpc('saveMetadata')
     }
 
+    /**
+     * Export the time the layout spent in its phases so far, with the slowest measures and systems, as JSON string
+     * @returns {Promise<string>}
+     */
+    saveLayoutProfile() {
+        return this.rpc('saveLayoutProfile')
+    }
+
     /**
      * @param {boolean=} soft (default `true`)
      *                 * `true`  destroy the score instance only, or
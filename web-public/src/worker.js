@@ -7,7 +7,7 @@ import WebMscore from './index.js'
 let score
 
 /**
- * @typedef {{ id: number; method: Exclude<keyof import('./index').default, 'scoreptr' | 'excerptId'> | 'load' | 'ready'; params: any[]; }} RPCReq
+ * @typedef {{ id: number; method: Exclude<keyof import('./index').default, 'scoreptr' | 'excerptId'> | 'load' | 'scanMetadata' | 'ready'; params: any[]; }} RPCReq
  * @typedef {{ id: number; result?: any; error?: any; }} RPCRes
  * @param {number} id 
  * @param {any} result 
@@ -73,6 +73,11 @@ self.onmessage = async (e) => {
                 rpcRes(id, 'done')
                 break;
 
+            case 'scanMetadata':
+                await WebMscore.ready
+                rpcRes(id, await WebMscore.scanMetadata.apply(undefined, params))
+                break
+
             default:
                 if (!score) { rpcErr(id, new Error('Score not loaded')) }
                 const result = await score[method].apply(score, params)
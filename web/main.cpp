@@ -4,11 +4,14 @@
 #include "libmscore/excerpt.h"
 #include "libmscore/part.h"
 #include "libmscore/importexports.h"
+#include "libmscore/layoutprofile.h"
 #include "libmscore/mscore.h"
 #include "libmscore/score.h"
+#include "libmscore/staff.h"
 #include "libmscore/text.h"
 #include "libmscore/undo.h"
 #include "mscore/preferences.h"
+#include "importexport/midiimport/importmidi_operations.h"
 
 /**
  * helper functions
@@ -38,7 +41,50 @@ QByteArray padData(QByteArray data) {
     return QByteArray(8, '\0').append(data);
 }
 
-Ms::Score* maybeUseExcerpt(Ms::Score* score, int excerptId) {
+/**
+ * whether the page header or footer shows the page number or the number of pages (`$n`, `$N`),
+ * which are only right once every page is laid out
+ */
+bool showsPageCount(Ms::Score* score) {
+    static const Ms::Sid headerFooter[] = {
+        Ms::Sid::evenHeaderL, Ms::Sid::evenHeaderC, Ms::Sid::evenHeaderR,
+        Ms::Sid::oddHeaderL,  Ms::Sid::oddHeaderC,  Ms::Sid::oddHeaderR,
+        Ms::Sid::evenFooterL, Ms::Sid::evenFooterC, Ms::Sid::evenFooterR,
+        Ms::Sid::oddFooterL,  Ms::Sid::oddFooterC,  Ms::Sid::oddFooterR,
+    };
+    if (!score->styleB(Ms::Sid::showHeader) && !score->styleB(Ms::Sid::showFooter)) {
+        return false;
+    }
+    for (Ms::Sid sid : headerFooter) {
+        const QString s = score->styleSt(sid);
+        if (s.contains("$n") || s.contains("$N")) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * the layout results saved with the score (see `_saveMsc`), for the score or a part
+ * empty if there are none, or if the score is not laid out in page mode as the cache was
+ */
+QJsonObject cachedLayout(Ms::Score* score, int excerptId) {
+    Ms::MasterScore* master = score->masterScore();
+    if (master->layoutCache().isEmpty() || master->layoutMode() != Ms::LayoutMode::PAGE) {
+        return QJsonObject();
+    }
+    QJsonObject json = QJsonDocument::fromJson(master->layoutCache()).object();
+    if (excerptId >= 0) {
+        json = json.value("excerpts").toArray().at(excerptId).toObject();
+    }
+    return json;
+}
+
+/**
+ * @param npages the number of pages the caller needs laid out, -1 for all of them
+ *               (1 is enough if only the start of the layout is needed: the thumbnail, `updateVelo` for playback)
+ */
+Ms::Score* maybeUseExcerpt(Ms::Score* score, int excerptId, int npages = -1) {
     // -1 means the full score
     if (excerptId >= 0) {
         QList<Ms::Excerpt*> excerpts = score->excerpts();
@@ -47,10 +93,33 @@ Ms::Score* maybeUseExcerpt(Ms::Score* score, int excerptId) {
             throw(QString("Not a valid excerptId."));
         }
 
-        score = excerpts[excerptId]->partScore();
+        Ms::Excerpt* excerpt = excerpts[excerptId];
+        if (score->masterScore()->readDeferredExcerpt(excerpt)) {
+            // the part is read on first use, see `MScore::deferExcerpts` in `_init`
+            // it is laid out in the mode `_load` chose for the score
+            excerpt->partScore()->setPlaylistDirty();
+            excerpt->partScore()->setLayoutMode(score->layoutMode());
+            qDebug("readExcerpt: %d", excerptId);
+        }
+
+        score = excerpt->partScore();
         qDebug("useExcerpt: %d", excerptId);
     }
 
+    // the layout is done on demand, see `doLayoutPages` in `_load`
+    // a score loaded with a layout cache is not laid out before it is needed here
+    if (!score->masterScore()->pages().isEmpty() || !score->masterScore()->layoutCache().isEmpty()) {
+        if (npages > 0 && showsPageCount(score)) {
+            npages = -1;
+        }
+        if (!score->layoutValid(score->layoutMode())) {  // a part not laid out yet, or changed since
+            score->addLayoutFlags(Ms::LayoutFlag::FIX_PITCH_VELO);
+            score->doLayoutPages(npages);
+        } else {
+            score->continueLayout(npages);
+        }
+    }
+
     return score;
 }
 
@@ -71,6 +140,8 @@ void _init(int argc, char** argv) {
 
     Ms::MScore::noGui = true;
     Ms::MScore::debugMode = false;
+    Ms::MScore::deferExcerpts = true;  // parts (excerpts) are read from the file and laid out when first used
+    Ms::MScore::profileLayout = true;  // time the layout phases, see `_saveLayoutProfile`
     Ms::MScore::init();
 }
 
@@ -90,8 +161,10 @@ bool _addFont(const char* fontPath) {
 
 /**
  * load the score data (a MSCZ/MSCX file buffer)
+ * @param layoutMode the `Ms::LayoutMode` to lay the score out in (page mode by default),
+ *                   or -1 for the mode the score was saved in
  */
-uintptr_t _load(const char* format, const char* data, const uint32_t size, bool doLayout) {
+uintptr_t _load(const char* format, const char* data, const uint32_t size, bool doLayout, int layoutMode) {
     using namespace Ms;
 
     QString _format = QString::fromUtf8(format);  // file format of the data
@@ -99,37 +172,35 @@ uintptr_t _load(const char* format, const char* data, const uint32_t size, bool
     MasterScore* score = new MasterScore(MScore::baseStyle());
     score->setMovements(new Movements());
 
-    // create a temporary file, and write `data` into it
-    QTemporaryFile tempfile("XXXXXX." + _format);  // filename template for the temporary file
-    if (!tempfile.open()) { // a QTemporaryFile will always be opened in `QIODevice::ReadWrite` mode
-        throw QString("Cannot create a temporary file");
-    } else {
-        tempfile.write(data, size);
-        tempfile.close(); // calls QFileDevice::flush() and closes the file
-    }
-    QString name = tempfile.fileName(); // temporary filename
+    // read straight from `data`, the buffer is not copied
+    // the file name only tells the importers which format to expect
+    QByteArray bytes = QByteArray::fromRawData(data, size);
+    QBuffer buffer(&bytes);
+    QString name = "score." + _format;
 
     // mtest/testutils.cpp#L108-L134 readCreatedScore
     // mscore/file.cpp#L2320 readScore
     Score::FileError rv;
-    if (_format == "mscz" || _format == "mscx")
-        rv = score->loadMsc(name, true);
+    if (_format == "mscz" || _format == "mscx") {
+        buffer.open(QIODevice::ReadOnly);
+        rv = score->loadMsc(name, &buffer, true);
+    }
     else if (_format == "mxl")
-        rv = importCompressedMusicXml(score, name);
+        rv = importCompressedMusicXml(score, &buffer, name);
     else if (_format == "xml" || _format == "musicxml")
-        rv = importMusicXml(score, name);
-    else if (_format == "midi" || _format == "kar")
-        rv = importMidi(score, name);
+        rv = importMusicXml(score, &buffer, name);
+    else if (_format == "midi" || _format == "kar") {
+        rv = importMidi(score, bytes, name);
+        // the per-file import state is only needed by the MIDI import panel
+        midiImportOperations.excludeMidiFile(name);
+    }
     else if (_format == "gtp" || _format == "gp3" || _format == "gp4" || _format == "gp5" || _format == "gpx" || _format == "gp" || _format == "ptb")
-        rv = importGTP(score, name);
+        rv = importGTP(score, &buffer, name);
     else {
         qWarning("Invalid file format");
         rv = Score::FileError::FILE_UNKNOWN_TYPE;
     }
 
-    // delete the temporary file
-    tempfile.remove();
-
     // handle exceptions
     if (rv != Score::FileError::FILE_NO_ERROR) {
         return char(rv);
@@ -140,6 +211,20 @@ uintptr_t _load(const char* format, const char* data, const uint32_t size, bool
         score->setMetaTag("originalFormat", _format);
         score->connectTies();
     }
+    if (_format == "midi" || _format == "kar") {
+        // bring the imported MIDI score into the state Score::read leaves a loaded score in,
+        // so it can be laid out and rendered without being reloaded from MSCX
+        // (the other imports were never reloaded, and are left as they are)
+        // libmscore/read302.cpp Score::read, MasterScore::read
+        score->fixTicks();
+        for (Part* p : score->parts()) {
+            p->updateHarmonyChannels(false);
+        }
+        for (Staff* s : score->staves()) {
+            s->updateOttava();
+        }
+        score->setCreated(false);
+    }
 
     // mscore/file.cpp#L2387 readScore
     score->rebuildMidiMapping();
@@ -152,10 +237,22 @@ uintptr_t _load(const char* format, const char* data, const uint32_t size, bool
     score->updateChannel();
     // score->updateExpressive(MuseScore::synthesizer("Fluid"));
 
+    // the score file may be saved in continuous mode, switch before the layout so it is done only once
+    if (layoutMode >= 0) {
+        for (auto s : score->scoreList()) {
+            s->setLayoutMode(LayoutMode(layoutMode));
+        }
+    }
+
     if (doLayout) {
-        // do layout ...
-        score->update();
-        score->switchToPageMode();  // the default _layoutMode is LayoutMode::PAGE, but the score file may be saved in continuous mode
+        if (cachedLayout(score, -1).isEmpty()) {
+            // lay out the first page only, the rest is laid out on demand (see `maybeUseExcerpt`)
+            score->doLayoutPages(1);
+        } else {
+            // the page count and positions are taken from the cache, the pages are laid out on demand
+            qDebug("load: layout cache");
+        }
+        score->cmdState().reset();
     }
 
     return reinterpret_cast<uintptr_t>(score);
@@ -186,6 +283,7 @@ void _generateExcerpts(uintptr_t score_ptr) {
         // add this excerpt back to the score excerpt list
         scoreExcerpts.append(e);
     }
+    score->cmdState().reset();  // the parts are laid out on first use, the score is unchanged
 
     qDebug("Generated excerpts: size %d", excerpts.size());
 }
@@ -216,6 +314,12 @@ QByteArray _title(uintptr_t score_ptr) {
  */
 int _npages(uintptr_t score_ptr, int excerptId) {
     auto score = reinterpret_cast<Ms::Score*>(score_ptr);
+
+    QJsonObject cached = cachedLayout(score, excerptId);
+    if (!cached.isEmpty()) {
+        return cached.value("pages").toInt();
+    }
+
     score = maybeUseExcerpt(score, excerptId);
     return score->npages();
 }
@@ -258,12 +362,34 @@ const char* _saveMxl(uintptr_t score_ptr, int excerptId) {
     return packData(buffer.data(), size);
 }
 
+/**
+ * the layout results `cachedLayout` reads back: the number of pages and the positions
+ * of measures and segments in page mode
+ */
+QJsonObject layoutCacheJSON(Ms::Score* score, int excerptId) {
+    score = maybeUseExcerpt(score, excerptId);
+
+    // the cache is made in page mode, the mode saved with the score (`<layoutMode>`) stays as it is
+    const Ms::LayoutMode layoutMode = score->layoutMode();
+    score->switchToPageMode();
+
+    QJsonObject json;
+    json.insert("pages", score->npages());
+    json.insert("measures", Ms::savePositions(score, false));
+    json.insert("segments", Ms::savePositions(score, true));
+
+    score->setLayoutMode(layoutMode);  // laid out again in this mode when it is used next
+    return json;
+}
+
 /**
  * save part score as MSCZ/MSCX file
+ * @param layoutCache save the layout results of the score and of its parts in the MSCZ file,
+ *                    a later `_load` of the file takes the page count and positions from there
  */
-const char* _saveMsc(uintptr_t score_ptr, bool compressed, int excerptId) {
+const char* _saveMsc(uintptr_t score_ptr, bool compressed, int excerptId, bool layoutCache) {
     auto score = reinterpret_cast<Ms::Score*>(score_ptr);
-    score = maybeUseExcerpt(score, excerptId);
+    score = maybeUseExcerpt(score, excerptId, 1);
 
     if (!score->isMaster()) {  // clone metaTags from masterScore
         QMapIterator<QString, QString> j(score->masterScore()->metaTags());
@@ -277,6 +403,19 @@ const char* _saveMsc(uintptr_t score_ptr, bool compressed, int excerptId) {
         }
     }
 
+    if (compressed && layoutCache) {
+        QJsonObject json = layoutCacheJSON(score, -1);
+        if (score->isMaster()) {
+            QJsonArray excerpts;
+            for (int i = 0; i < score->excerpts().size(); ++i) {
+                excerpts.append(layoutCacheJSON(score, i));
+            }
+            json.insert("excerpts", excerpts);
+        }
+        // made for the content saved next, saveCompressedFile only saves it if it still matches
+        score->setLayoutCache(QJsonDocument(json).toJson(QJsonDocument::Compact));
+    }
+
     QBuffer buffer;
     buffer.open(QIODevice::ReadWrite);
 
@@ -307,7 +446,7 @@ const char* _saveMsc(uintptr_t score_ptr, bool compressed, int excerptId) {
  */
 const char* _saveSvg(uintptr_t score_ptr, int pageNumber, bool drawPageBackground, int excerptId) {
     auto score = reinterpret_cast<Ms::Score*>(score_ptr);
-    score = maybeUseExcerpt(score, excerptId);
+    score = maybeUseExcerpt(score, excerptId, pageNumber + 1);
 
     QBuffer buffer;
     buffer.open(QIODevice::WriteOnly);
@@ -327,7 +466,7 @@ const char* _saveSvg(uintptr_t score_ptr, int pageNumber, bool drawPageBackgroun
  */
 const char* _savePng(uintptr_t score_ptr, int pageNumber, bool drawPageBackground, bool transparent, int excerptId) {
     auto score = reinterpret_cast<Ms::Score*>(score_ptr);
-    score = maybeUseExcerpt(score, excerptId);
+    score = maybeUseExcerpt(score, excerptId, pageNumber + 1);
 
     QBuffer buffer;
     buffer.open(QIODevice::WriteOnly);
@@ -364,7 +503,7 @@ const char* _savePdf(uintptr_t score_ptr, int excerptId) {
  */
 const char* _saveMidi(uintptr_t score_ptr, bool midiExpandRepeats, bool exportRPNs, int excerptId) {
     auto score = reinterpret_cast<Ms::Score*>(score_ptr);
-    score = maybeUseExcerpt(score, excerptId);
+    score = maybeUseExcerpt(score, excerptId, 1);
 
     QBuffer buffer;
     buffer.open(QIODevice::ReadWrite);
@@ -382,7 +521,7 @@ const char* _saveMidi(uintptr_t score_ptr, bool midiExpandRepeats, bool exportRP
  */
 const char* _saveAudio(uintptr_t score_ptr, const char* format, int excerptId) {
     auto score = reinterpret_cast<Ms::Score*>(score_ptr);
-    score = maybeUseExcerpt(score, excerptId);
+    score = maybeUseExcerpt(score, excerptId, 1);
 
     // file format of the output file
     // "wav", "ogg", "flac", or "mp3"
@@ -415,7 +554,7 @@ const char* _saveAudio(uintptr_t score_ptr, const char* format, int excerptId) {
  */
 uintptr_t _synthAudio(uintptr_t score_ptr, float starttime, int excerptId) {
     auto score = reinterpret_cast<Ms::Score*>(score_ptr);
-    score = maybeUseExcerpt(score, excerptId);
+    score = maybeUseExcerpt(score, excerptId, 1);
 
     qDebug("synthAudio: excerpt %d, starttime %f", excerptId, starttime);
 
@@ -445,10 +584,13 @@ const char* _processSynthBatch(uintptr_t fn_ptr, int batchSize, bool cancel) {
  */
 const char* _savePositions(uintptr_t score_ptr, bool ofSegments, int excerptId) {
     auto score = reinterpret_cast<Ms::Score*>(score_ptr);
-    score = maybeUseExcerpt(score, excerptId);
 
-    score->switchToPageMode();
-    QJsonObject json = Ms::savePositions(score, ofSegments);
+    QJsonObject json = cachedLayout(score, excerptId).value(ofSegments ? "segments" : "measures").toObject();
+    if (json.isEmpty()) {
+        score = maybeUseExcerpt(score, excerptId);
+        score->switchToPageMode();
+        json = Ms::savePositions(score, ofSegments);
+    }
     QJsonDocument saveDoc(json);
 
     auto data = saveDoc.toJson(QJsonDocument::Compact);  // UTF-8 encoded JSON data
@@ -460,11 +602,91 @@ const char* _savePositions(uintptr_t score_ptr, bool ofSegments, int excerptId)
 
 /**
  * save score metadata as JSON
+ * the excerpts are listed without reading their part scores (see `MScore::deferExcerpts`),
+ * but `pages` needs the complete layout of the score: unless the layout cache has it,
+ * the rest of the layout `_load` started on the first page is done here
  */
 const char* _saveMetadata(uintptr_t score_ptr) {
     Ms::MasterScore* score = reinterpret_cast<Ms::MasterScore*>(score_ptr);
 
+    QJsonObject cached = cachedLayout(score, -1);
+    if (cached.isEmpty()) {
+        score->continueLayout();  // the number of pages
+    }
     QJsonObject json = saveMetadataJSON(score);
+    if (!cached.isEmpty()) {
+        json.insert("pages", cached.value("pages"));  // the score may not be laid out yet
+    }
+    QJsonDocument saveDoc(json);
+
+    // JSON is plain text
+    return padData(
+        saveDoc.toJson()  // UTF-8 encoded JSON data
+    );
+}
+
+/**
+ * save the time the layout of the score (or of a part) spent in its phases so far as JSON,
+ * with the slowest measures and systems
+ * a part that has not been used yet has no layout, and an empty profile
+ */
+const char* _saveLayoutProfile(uintptr_t score_ptr, int excerptId) {
+    auto score = reinterpret_cast<Ms::Score*>(score_ptr);
+
+    if (excerptId >= 0) {
+        QList<Ms::Excerpt*> excerpts = score->excerpts();
+        if (excerptId >= excerpts.size()) {
+            throw(QString("Not a valid excerptId."));
+        }
+        score = excerpts[excerptId]->partScore();  // no layout here, unlike `maybeUseExcerpt`
+    }
+
+    QJsonObject json;
+    if (score && score->hasLayoutProfile()) {
+        json = score->layoutProfile()->toJson();
+    } else {
+        json = Ms::LayoutProfile().toJson();
+    }
+    QJsonDocument saveDoc(json);
+
+    auto data = saveDoc.toJson(QJsonDocument::Compact);  // UTF-8 encoded JSON data
+    qDebug("saveLayoutProfile: excerpt %d, size %d bytes", excerptId, data.size());
+
+    // JSON is plain text
+    return padData(data);
+}
+
+/**
+ * scan the score metadata off the file data without loading the score
+ * the fields a scan cannot provide (see Ms::scanMetadataJSON) are left out,
+ * or are taken from a full load if `full` is set
+ */
+const char* _scanMetadata(const char* format, const char* data, const uint32_t size, bool full) {
+    QString _format = QString::fromUtf8(format);
+    QByteArray bytes = QByteArray::fromRawData(data, size);
+
+    QJsonObject json;
+    QStringList missing;
+    bool scanned = Ms::scanMetadataJSON(bytes, "score." + _format, &json, &missing);
+    qDebug("scanMetadata: scanned %d, missing <%s>", scanned, qPrintable(missing.join(',')));
+
+    if (!scanned || (full && !missing.isEmpty())) {
+        uintptr_t score_ptr = _load(format, data, size, false, -1);
+        if (score_ptr < 16) {  // error code
+            throw QString("Cannot load the score");
+        }
+        Ms::MasterScore* score = reinterpret_cast<Ms::MasterScore*>(score_ptr);
+        QJsonObject loaded = Ms::saveMetadataJSON(score);
+        if (!scanned) {
+            json = loaded;
+        } else {
+            for (const QString& key : missing) {
+                json.insert(key, loaded.value(key));
+            }
+        }
+        delete score;
+    }
+
     QJsonDocument saveDoc(json);
 
     // JSON is plain text
@@ -494,8 +716,8 @@ extern "C" {
     };
 
     EMSCRIPTEN_KEEPALIVE
-    uintptr_t load(const char* format, const char* data, const uint32_t size, bool doLayout = true) {
-        return _load(format, data, size, doLayout);
+    uintptr_t load(const char* format, const char* data, const uint32_t size, bool doLayout = true, int layoutMode = 0) {
+        return _load(format, data, size, doLayout, layoutMode);
     };
 
     EMSCRIPTEN_KEEPALIVE
@@ -524,8 +746,8 @@ extern "C" {
     };
 
     EMSCRIPTEN_KEEPALIVE
-    const char* saveMsc(uintptr_t score_ptr, bool compressed, int excerptId = -1) {
-        return _saveMsc(score_ptr, compressed, excerptId);
+    const char* saveMsc(uintptr_t score_ptr, bool compressed, int excerptId = -1, bool layoutCache = false) {
+        return _saveMsc(score_ptr, compressed, excerptId, layoutCache);
     };
 
     EMSCRIPTEN_KEEPALIVE
@@ -578,6 +800,16 @@ extern "C" {
         return _saveMetadata(score_ptr);
     };
 
+    EMSCRIPTEN_KEEPALIVE
+    const char* saveLayoutProfile(uintptr_t score_ptr, int excerptId = -1) {
+        return _saveLayoutProfile(score_ptr, excerptId);
+    };
+
+    EMSCRIPTEN_KEEPALIVE
+    const char* scanMetadata(const char* format, const char* data, const uint32_t size, bool full = false) {
+        return _scanMetadata(format, data, size, full);
+    };
+
     EMSCRIPTEN_KEEPALIVE
     void destroy(uintptr_t score_ptr) {
         delete (Ms::MasterScore*)score_ptr;